@@ -0,0 +1,123 @@
+// Compares the throughput of the batch conversions with a loop of single conversions.
+//
+//   g++ -std=c++17 -O2 -I../include batch_conversion.cpp -o batch_conversion
+
+#include <enum_utils/conversion.h>
+#include <enum_utils/preload.h>
+#include <enum_utils/range.h>
+#include <enum_utils/traits.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+enum class e8 { first, last = 7 };
+enum class e64 { first, last = 63 };
+enum class e512 { first, last = 511 };
+enum class e4096 { first, last = 4095 };
+
+ENUM_UTILS_DEFINE_TRAITS_FL(e8, first, last)
+ENUM_UTILS_DEFINE_TRAITS_FL(e64, first, last)
+ENUM_UTILS_DEFINE_TRAITS_FL(e512, first, last)
+ENUM_UTILS_DEFINE_TRAITS_FL(e4096, first, last)
+
+// The names are too many to define with a macro each, so the whole generator is specialized instead.
+template <typename E>
+struct enum_utils::conversion_generator<E, std::string>
+{
+  template <E e>
+  struct impl
+  {
+    std::string operator()() const
+    {
+      return "token_" + std::to_string(enum_utils::size<E>()) + "_" + std::to_string(index(e) * 7919 % 100003);
+    }
+  };
+};
+
+constexpr std::size_t keys_count  = 4000000;
+constexpr int         repetitions = 5;
+
+// Millions of elements per second, the best of several repetitions.
+template <typename F>
+double measure(F f)
+{
+  auto result = 0.0;
+
+  for (int i = 0; i < repetitions; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    result = i == 0 || keys_count / time > result ? keys_count / time : result;
+  }
+
+  return result;
+}
+
+template <typename E>
+void run()
+{
+  enum_utils::preload<E, std::string>();
+
+  // One key in twenty is unknown.
+  auto names  = std::vector<std::string>{};
+  auto random = std::mt19937{42};
+
+  for (auto e : enum_utils::range<E>{})
+    names.push_back(enum_utils::convert_to_value<std::string>(e));
+
+  const auto unknown = std::string{"unknown_token"};
+  auto       keys    = std::vector<std::string_view>(keys_count);
+
+  for (auto& key : keys)
+    key = random() % 20 == 0 ? std::string_view{unknown} : std::string_view{names[random() % names.size()]};
+
+  auto items  = std::vector<E>(keys_count);
+  auto found  = std::unique_ptr<bool[]>{new bool[keys_count]};
+  auto values = std::vector<std::string_view>(keys_count);
+
+  const auto scalar_to_enum = measure([&] {
+    for (std::size_t i = 0; i < keys_count; ++i)
+    {
+      const auto result = enum_utils::try_convert_to_enum<E>(keys[i]);
+
+      items[i] = result.first;
+      found[i] = result.second;
+    }
+  });
+
+  const auto batch_to_enum = measure([&] {
+    enum_utils::try_convert_to_enum<E>(keys.data(), keys_count, items.data(), found.get());
+  });
+
+  const auto scalar_to_value = measure([&] {
+    for (std::size_t i = 0; i < keys_count; ++i)
+      values[i] = enum_utils::convert_to_value<std::string>(items[i]);
+  });
+
+  const auto batch_to_value = measure([&] {
+    enum_utils::convert_to_value<std::string>(items.data(), keys_count, values.begin());
+  });
+
+  std::printf("%5zu items: to enum %6.1f vs %6.1f M/s, to value %6.1f vs %6.1f M/s\n", names.size(), scalar_to_enum,
+      batch_to_enum, scalar_to_value, batch_to_value);
+}
+
+int main()
+{
+  std::printf("Scalar loop vs batch\n");
+
+  run<e8>();
+  run<e64>();
+  run<e512>();
+  run<e4096>();
+
+  return 0;
+}
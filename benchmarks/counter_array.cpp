@@ -0,0 +1,94 @@
+// Compares the throughput of counter_array with an array of atomic counters as more and more threads increment them.
+//
+//   g++ -std=c++17 -O2 -I../include counter_array.cpp -o counter_array -pthread
+//   ./counter_array [maximum thread count]
+//
+// The thread count doubles from 1 up to the maximum, which is twice the number of hardware threads by default. On a
+// single core, the threads take turns, so there's no false sharing to avoid.
+
+#include <enum_utils/array.h>
+#include <enum_utils/basic.h>
+#include <enum_utils/counter_array.h>
+#include <enum_utils/traits.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+
+enum class event { connect, disconnect, request, response, timeout, retry, error, drop, _last = drop };
+
+ENUM_UTILS_DEFINE_TRAITS(event, _last)
+
+constexpr std::uint64_t increments = 4000000;
+
+// Millions of increments per second over all the threads.
+template <typename F>
+double measure(unsigned threads, F increment)
+{
+  auto workers = std::vector<std::thread>{};
+  auto ready   = std::atomic<unsigned>{0};
+
+  const auto per_thread = increments / threads;
+
+  for (unsigned i = 0; i < threads; ++i)
+  {
+    workers.emplace_back([&, i] {
+      ready.fetch_add(1);
+
+      while (ready.load() != threads)
+        std::this_thread::yield();
+
+      for (std::uint64_t j = 0; j < per_thread; ++j)
+        increment(enum_utils::get<event>((i + j) % enum_utils::size<event>()));
+    });
+  }
+
+  while (ready.load() != threads)
+    std::this_thread::yield();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (auto& worker : workers)
+    worker.join();
+
+  const auto time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  return per_thread * threads / time;
+}
+
+int main(int argc, char** argv)
+{
+  const auto max_threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1]))
+                                    : 2 * std::max(1u, std::thread::hardware_concurrency());
+
+  std::printf("%7s %22s %22s\n", "threads", "counter_array, M/s", "array<atomic>, M/s");
+
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+  {
+    auto counters = enum_utils::counter_array<event>{};
+    auto atomics  = enum_utils::array<event, std::atomic<std::uint64_t>>::make();
+
+    const auto sharded = measure(threads, [&](event e) { counters.increment(e); });
+    const auto plain   = measure(threads, [&](event e) { atomics[e].fetch_add(1, std::memory_order_relaxed); });
+
+    auto total = std::uint64_t{0};
+
+    for (const auto count : counters.snapshot())
+      total += count;
+
+    if (total != increments / threads * threads)
+    {
+      std::printf("Lost increments\n");
+      return 1;
+    }
+
+    std::printf("%7u %22.1f %22.1f\n", threads, sharded, plain);
+  }
+
+  return 0;
+}
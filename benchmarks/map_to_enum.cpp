@@ -0,0 +1,120 @@
+// Compares try_map_to_enum() with the chain of compares it used to be, for values known at runtime only.
+//
+//   g++ -std=c++17 -O2 -I../include map_to_enum.cpp -o map_to_enum
+
+#include <enum_utils/basic.h>
+#include <enum_utils/mapping.h>
+#include <enum_utils/traits.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+enum class opcode { first, last = 299 };
+
+ENUM_UTILS_DEFINE_TRAITS_FL(opcode, first, last)
+
+// The values are too many to define with a macro each, so the mappings are specialized for all the items at once.
+// Compact values, a permutation of [100, 400).
+template <opcode e>
+struct enum_utils::mapped_value<opcode, e, int>
+{
+  static constexpr int value = static_cast<int>(index(e) * 7 % 300 + 100);
+};
+
+// Sparse values.
+template <opcode e>
+struct enum_utils::mapped_value<opcode, e, long long>
+{
+  static constexpr long long value = static_cast<long long>(index(e) * 7 % 300) * 1000003 - 150000000;
+};
+
+// Values that can only be ordered.
+template <opcode e>
+struct enum_utils::mapped_value<opcode, e, double>
+{
+  static constexpr double value = static_cast<double>(index(e) * 7 % 300) * 0.37 + 0.5;
+};
+
+// The way `try_map_to_enum()` used to look a value up: a compare per item, from the last one to the first one.
+template <typename E, typename T, int ind>
+constexpr std::pair<E, bool> chain_try_map_to_enum(const T& v) noexcept
+{
+  return v == enum_utils::mapped_value<E, enum_utils::get<E>(ind), T>::value
+             ? std::make_pair(enum_utils::get<E>(ind), true)
+             : ind == 0 ? std::make_pair(enum_utils::get<E>(ind), false)
+                        : chain_try_map_to_enum<E, T, std::max(ind - 1, 0)>(v);
+}
+
+constexpr int lookups     = 4096;
+constexpr int repetitions = 200;
+
+template <typename F>
+double measure(F f)
+{
+  auto result = 0.0;
+
+  for (int i = 0; i < repetitions; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    result = i == 0 || time < result ? time : result;
+  }
+
+  return result / lookups;
+}
+
+template <typename T>
+void run(const char* label)
+{
+  constexpr auto last = static_cast<int>(enum_utils::size<opcode>() - 1);
+
+  // One key in eight is not mapped to any item.
+  auto random = std::mt19937_64{1};
+  auto keys   = std::vector<T>{};
+
+  for (int i = 0; i < lookups; ++i)
+  {
+    keys.push_back(random() % 8 ? enum_utils::map_to_value<T>(enum_utils::get<opcode>(random() % (last + 1)))
+                                : -static_cast<T>(1 + random() % 1000));
+  }
+
+  for (const auto key : keys)
+  {
+    if (enum_utils::try_map_to_enum<opcode>(key) != chain_try_map_to_enum<opcode, T, last>(key))
+    {
+      std::printf("%s: mismatch\n", label);
+      std::exit(1);
+    }
+  }
+
+  auto sink = 0u;
+
+  const auto chain_time = measure([&] {
+    for (const auto key : keys)
+      sink += static_cast<unsigned>(chain_try_map_to_enum<opcode, T, last>(key).first);
+  });
+
+  const auto index_time = measure([&] {
+    for (const auto key : keys)
+      sink += static_cast<unsigned>(enum_utils::try_map_to_enum<opcode>(key).first);
+  });
+
+  std::printf("%-10s chain %7.2f ns, index %6.2f ns (%u)\n", label, chain_time, index_time, sink);
+}
+
+int main()
+{
+  run<int>("int");
+  run<long long>("long long");
+  run<double>("double");
+
+  return 0;
+}
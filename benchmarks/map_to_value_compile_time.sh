@@ -0,0 +1,42 @@
+#!/bin/sh
+# Measures the cost of map_to_value() at compile time: the time it takes to compile a translation unit with N
+# mappings and a single call of map_to_value() with an item known at runtime only, the size of the code and the
+# constants in the object file, and the number of instructions in it.
+#
+#   ./map_to_value_compile_time.sh [include directory] [compiler]
+#
+# To compare revisions, pass the include directory of another checkout.
+
+include_dir=${1:-$(dirname "$0")/../include}
+compiler=${2:-g++}
+work_dir=$(mktemp -d)
+trap 'rm -rf "$work_dir"' EXIT
+
+printf '%6s %10s %12s %14s\n' items 'time, ms' 'text, bytes' 'instructions'
+
+for n in 100 1000 5000; do
+  source="$work_dir/map_to_value_$n.cpp"
+  object="$work_dir/map_to_value_$n.o"
+
+  {
+    echo '#include <enum_utils/mapping.h>'
+    echo '#include <enum_utils/traits.h>'
+    echo "enum class item { first, last = $((n - 1)) };"
+    echo 'ENUM_UTILS_DEFINE_TRAITS_FL(item, first, last)'
+    i=0
+    while [ $i -lt $n ]; do
+      echo "ENUM_UTILS_DEFINE_MAPPING_TO_VALUE(static_cast<item>($i), $((i * 7 + 3)))"
+      i=$((i + 1))
+    done
+    echo 'int map(item e) { return enum_utils::map_to_value<int>(e); }'
+  } > "$source"
+
+  start=$(date +%s%N)
+  "$compiler" -std=c++17 -O2 -I"$include_dir" -c "$source" -o "$object" || exit 1
+  end=$(date +%s%N)
+
+  text=$(size "$object" | awk 'NR == 2 { print $1 }')
+  instructions=$(objdump -d "$object" | grep -c '^ *[0-9a-f]*:')
+
+  printf '%6d %10d %12d %14d\n' "$n" $(((end - start) / 1000000)) "$text" "$instructions"
+done
@@ -0,0 +1,57 @@
+#!/bin/sh
+# Measures the cost of mapped_enum at compile time: the time it takes to check the syntax of a translation unit with
+# N items, each mapped to a distinct type, and two mapped_enum queries, as well as without the queries.
+#
+#   ./mapped_enum_compile_time.sh [include directory] [compiler]
+#
+# To compare revisions, pass the include directory of another checkout. Extra compiler flags (a raised
+# -ftemplate-depth, say) are taken from CXXFLAGS, and every compilation is given up on after TIMEOUT seconds (600
+# by default).
+
+include_dir=${1:-$(dirname "$0")/../include}
+compiler=${2:-g++}
+work_dir=$(mktemp -d)
+trap 'rm -rf "$work_dir"' EXIT
+
+# Prints the time in milliseconds, or the reason there's none.
+compile()
+{
+  start=$(date +%s%N)
+  timeout "${TIMEOUT:-600}" "$compiler" -std=c++17 -fsyntax-only $CXXFLAGS -I"$include_dir" "$1" 2> /dev/null
+  status=$?
+  end=$(date +%s%N)
+
+  case $status in
+    0) echo $(((end - start) / 1000000)) ;;
+    124) echo 'timed out' ;;
+    *) echo 'failed' ;;
+  esac
+}
+
+printf '%6s %18s %18s\n' items 'definitions, ms' 'with queries, ms'
+
+for n in 1000 10000; do
+  definitions="$work_dir/definitions_$n.cpp"
+  queries="$work_dir/queries_$n.cpp"
+
+  {
+    echo '#include <enum_utils/mapping.h>'
+    echo '#include <enum_utils/traits.h>'
+    echo "enum class item { first, last = $((n - 1)) };"
+    echo 'ENUM_UTILS_DEFINE_TRAITS_FL(item, first, last)'
+    echo 'template <int> struct tag {};'
+    i=0
+    while [ $i -lt $n ]; do
+      echo "ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(static_cast<item>($i), tag<$i>)"
+      i=$((i + 1))
+    done
+  } > "$definitions"
+
+  {
+    cat "$definitions"
+    echo 'static_assert(enum_utils::mapped_enum<item, tag<0>>::value == item::first, "");'
+    echo "static_assert(enum_utils::mapped_enum<item, tag<$((n / 2))>>::value == static_cast<item>($((n / 2))), \"\");"
+  } > "$queries"
+
+  printf '%6d %18s %18s\n' "$n" "$(compile "$definitions")" "$(compile "$queries")"
+done
@@ -0,0 +1,100 @@
+// Compares the reverse lookup of conversion_table with a std::unordered_map built from the same values.
+//
+//   g++ -std=c++17 -O2 -I../include reverse_lookup.cpp -o reverse_lookup
+
+#include <enum_utils/conversion.h>
+#include <enum_utils/range.h>
+#include <enum_utils/traits.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+enum class e8 { first, last = 7 };
+enum class e64 { first, last = 63 };
+enum class e512 { first, last = 511 };
+enum class e4096 { first, last = 4095 };
+
+ENUM_UTILS_DEFINE_TRAITS_FL(e8, first, last)
+ENUM_UTILS_DEFINE_TRAITS_FL(e64, first, last)
+ENUM_UTILS_DEFINE_TRAITS_FL(e512, first, last)
+ENUM_UTILS_DEFINE_TRAITS_FL(e4096, first, last)
+
+constexpr std::size_t lookups     = 4000000;
+constexpr int         repetitions = 7;
+
+template <typename E>
+std::string make_name(E e)
+{
+  return "token_" + std::to_string(enum_utils::size<E>()) + "_" + std::to_string(enum_utils::index(e) * 7919 % 100003);
+}
+
+// The best of several repetitions, so that a noisy machine doesn't skew the comparison.
+template <typename F>
+double measure(std::size_t count, F f)
+{
+  auto result = 0.0;
+
+  for (int i = 0; i < repetitions; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+
+    result = i == 0 || time < result ? time : result;
+  }
+
+  return result;
+}
+
+template <typename E>
+void run()
+{
+  const auto table = enum_utils::conversion_table<E, std::string>{make_name<E>};
+  auto       map   = std::unordered_map<std::string, E>{};
+  auto       keys  = std::vector<std::string>{};
+
+  for (auto e : enum_utils::range<E>{})
+  {
+    keys.push_back(make_name(e));
+    map.emplace(keys.back(), e);
+  }
+
+  table.preload();
+
+  // The keys come in random order: a fixed sequence of a few hundred keys would let the branch predictor learn it.
+  auto order  = std::vector<const std::string*>(lookups);
+  auto random = std::mt19937{42};
+
+  for (auto& key : order)
+    key = &keys[random() % keys.size()];
+
+  auto sink = 0u;
+
+  const auto table_time = measure(order.size(), [&] {
+    for (const auto key : order)
+      sink += static_cast<unsigned>(table.convert_to_enum(*key));
+  });
+
+  const auto map_time = measure(order.size(), [&] {
+    for (const auto key : order)
+      sink += static_cast<unsigned>(map.find(*key)->second);
+  });
+
+  std::printf("%5zu items: conversion_table %6.2f ns, unordered_map %6.2f ns (%u)\n", keys.size(), table_time, map_time,
+      sink);
+}
+
+int main()
+{
+  run<e8>();
+  run<e64>();
+  run<e512>();
+  run<e4096>();
+
+  return 0;
+}
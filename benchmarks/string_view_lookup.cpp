@@ -0,0 +1,121 @@
+// Counts the allocations made by convert_to_enum() when the keys are slices of a buffer, looked up either as strings
+// made of the slices or as the slices themselves.
+//
+//   g++ -std=c++17 -O2 -I../include string_view_lookup.cpp -o string_view_lookup
+
+#include <enum_utils/conversion.h>
+#include <enum_utils/preload.h>
+#include <enum_utils/range.h>
+#include <enum_utils/traits.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+enum class token { first, last = 511 };
+
+ENUM_UTILS_DEFINE_TRAITS_FL(token, first, last)
+
+// The names are too many to define with a macro each, so the whole generator is specialized instead.
+template <>
+struct enum_utils::conversion_generator<token, std::string>
+{
+  template <token e>
+  struct impl
+  {
+    std::string operator()() const { return "message_type_" + std::to_string(enum_utils::index(e) * 7919 % 100003); }
+  };
+};
+
+constexpr std::size_t lookups = 1000000;
+
+static std::size_t allocations = 0;
+
+// GCC takes the replaced operators, once inlined, for a mismatch between `new` and `free()`.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+
+  if (const auto result = std::malloc(size))
+    return result;
+
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+
+template <typename F>
+void measure(const char* label, F f)
+{
+  const auto before = allocations;
+  const auto start  = std::chrono::steady_clock::now();
+  const auto sink   = f();
+  const auto time   = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  std::printf("%-24s %8zu allocations, %6.2f ns per lookup (%u)\n", label, allocations - before, time / lookups, sink);
+}
+
+int main()
+{
+  enum_utils::preload<token, std::string>();
+
+  // The names are too long for the small string optimization, so a string made of a slice allocates.
+  auto buffer = std::string{};
+  auto slices = std::vector<std::string_view>{};
+
+  for (auto e : enum_utils::range<token>{})
+    buffer += ' ' + enum_utils::convert_to_value<std::string>(e);
+
+  for (std::size_t first = 0, last = 0; first < buffer.size(); first = last)
+  {
+    first = buffer.find_first_not_of(' ', first);
+    last  = buffer.find(' ', first);
+    slices.push_back(std::string_view{buffer}.substr(first, last - first));
+  }
+
+  auto keys   = std::vector<std::string_view>(lookups);
+  auto random = std::mt19937{42};
+
+  for (auto& key : keys)
+    key = slices[random() % slices.size()];
+
+  measure("std::string", [&] {
+    auto sink = 0u;
+
+    for (const auto key : keys)
+      sink += static_cast<unsigned>(enum_utils::convert_to_enum<token>(std::string{key}));
+
+    return sink;
+  });
+
+  measure("std::string_view", [&] {
+    auto sink = 0u;
+
+    for (const auto key : keys)
+      sink += static_cast<unsigned>(enum_utils::convert_to_enum<token>(key));
+
+    return sink;
+  });
+
+  measure("pointer and length", [&] {
+    auto sink = 0u;
+
+    for (const auto key : keys)
+      sink += static_cast<unsigned>(enum_utils::convert_to_enum<token>(key.data(), key.size()));
+
+    return sink;
+  });
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <enum_utils/algorithm.h>
+#include <enum_utils/mapping.h>
+#include <enum_utils/traits.h>
+
+#include <cstddef>
+#include <iostream>
+
+
+enum class column { id, price, weight, _last = weight };
+
+ENUM_UTILS_DEFINE_TRAITS(column, _last)
+
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(column::id,     int)
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(column::price,  double)
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(column::weight, float)
+
+ENUM_UTILS_DEFINE_MAPPING_TO_VALUE(column::id,     8 )
+ENUM_UTILS_DEFINE_MAPPING_TO_VALUE(column::price,  12)
+ENUM_UTILS_DEFINE_MAPPING_TO_VALUE(column::weight, 10)
+
+// The items are constant expressions inside the functor, so they can be used with compile time mapping.
+constexpr auto row_size = enum_utils::fold<column>(std::size_t{0}, [](std::size_t size, auto c) {
+  return size + sizeof(enum_utils::mapped_type_t<column, decltype(c)::value>);
+});
+
+static_assert(row_size == sizeof(int) + sizeof(double) + sizeof(float), "OK");
+
+static_assert(enum_utils::all_of<column>([](auto c) { return enum_utils::map_to_value<int>(c()) >= 8; }), "OK");
+static_assert(!enum_utils::any_of<column>([](auto c) { return enum_utils::map_to_value<int>(c()) > 12; }), "OK");
+
+
+int main(int, char*)
+{
+  enum_utils::for_each<column>([](auto c) {
+    std::cout << "Column #" << static_cast<int>(c()) << " is " << enum_utils::map_to_value<int>(c()) << " wide"
+              << std::endl;
+  });
+
+  return 0;
+}
@@ -1,6 +1,9 @@
 #include <enum_utils/array.h>
 #include <enum_utils/traits.h>
 
+#include <mutex>
+#include <vector>
+
 
 enum class enumeration { a, b, c, _last = c };
 
@@ -18,3 +21,35 @@ struct squared_index_generator
 static const auto squared_indices =
     enum_utils::array<enumeration, std::size_t>::make<squared_index_generator>(); // { 0, 1, 4 }
 static const auto squared_index_of_c = squared_indices[enumeration::c];           // 4
+
+// The generation takes place at compile time, so the tables are constant initialized: nothing is done at startup.
+constexpr auto constant_squared_indices = enum_utils::array<enumeration, std::size_t>::make<squared_index_generator>();
+
+static_assert(constant_squared_indices[enumeration::c] == 4, "OK");
+static_assert(constant_squared_indices.at(enumeration::b) == 1, "OK");
+static_assert(*constant_squared_indices.begin() == 0, "OK");
+
+// The same table, shared by every translation unit.
+static_assert(enum_utils::static_array<enumeration, std::size_t, squared_index_generator>.back() == 4, "OK");
+
+// A mutable table which is still guaranteed to be filled in at compile time.
+ENUM_UTILS_CONSTINIT static auto mutable_squared_indices =
+    enum_utils::array<enumeration, std::size_t>::make<squared_index_generator>();
+
+// Neither movable nor copyable elements are constructed in place.
+static auto locks = enum_utils::array<enumeration, std::mutex>::make();
+
+// The arguments are passed to every generator, or to the constructors if there's no generator.
+template <enumeration e>
+struct buffer_generator
+{
+  std::vector<char> operator()(std::size_t capacity) const { return std::vector<char>(capacity << enum_utils::index(e)); }
+};
+
+std::size_t make_buffers(std::size_t capacity)
+{
+  const auto same_sized = enum_utils::array<enumeration, std::vector<char>>::make(capacity);
+  const auto scaled     = enum_utils::array<enumeration, std::vector<char>>::make<buffer_generator>(capacity);
+
+  return same_sized[enumeration::c].size() + scaled[enumeration::c].size(); // capacity + capacity * 4
+}
@@ -0,0 +1,39 @@
+#include <enum_utils/array.h>
+#include <enum_utils/bitset.h>
+#include <enum_utils/range.h>
+#include <enum_utils/traits.h>
+
+#include <iostream>
+
+
+enum class permission { read, write, execute, list, create, remove, _last = remove };
+
+ENUM_UTILS_DEFINE_TRAITS(permission, _last)
+
+using permissions = enum_utils::bitset<permission>;
+
+constexpr auto reader = permissions{permission::read, permission::list};
+constexpr auto editor = reader | permissions{permission::write, permission::create, permission::remove};
+
+static_assert(editor.count() == 5, "OK");
+static_assert(reader.is_subset_of(editor), "OK");
+static_assert((editor - reader).test(permission::write), "OK");
+static_assert(!(editor & ~reader).test(permission::read), "OK");
+
+
+int main(int, char*)
+{
+  // Only the set items are visited.
+  for (auto p : editor - reader)
+    std::cout << "editors may also " << static_cast<int>(p) << std::endl;
+
+  // The items of a range, set a word at a time.
+  const auto modifying = permissions{enum_utils::range<permission>{permission::write, permission::execute}};
+
+  auto costs = enum_utils::array<permission, int>::make();
+  enum_utils::masked_fill(costs, modifying, 10);
+
+  std::cout << "writing costs " << costs[permission::write] << ", reading costs " << costs[permission::read] << std::endl;
+
+  return 0;
+}
@@ -53,5 +53,9 @@ int main(int, char*)
   if (enum_utils::convert_to_enum(data{"C"}, enumeration::unknown) == enumeration::unknown)
     std::cout << "Conversion using the fallback value always works, though" << std::endl;
 
+  // The non-throwing conversion reports failures the same way `try_map_to_enum()` does.
+  if (!enum_utils::try_convert_to_enum<enumeration>(data{"C"}).second)
+    std::cout << "Failed conversions can be checked without exceptions" << std::endl;
+
   return 0;
 }
@@ -0,0 +1,53 @@
+#include <enum_utils/conversion.h>
+#include <enum_utils/traits.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+
+enum class color { red, green, blue, _last = blue };
+
+ENUM_UTILS_DEFINE_TRAITS(color, _last)
+
+ENUM_UTILS_DEFINE_CONVERSION(color::red,   std::string{"red"})
+ENUM_UTILS_DEFINE_CONVERSION(color::green, std::string{"green"})
+ENUM_UTILS_DEFINE_CONVERSION(color::blue,  std::string{"blue"})
+
+
+std::string german_name(color c)
+{
+  switch (c) {
+    case color::red:   return "rot";
+    case color::green: return "gruen";
+    case color::blue:  return "blau";
+  }
+
+  return {};
+}
+
+
+int main(int, char*)
+{
+  // Built from the conversions defined above, just like the implicit table of `convert_to_value()`.
+  const auto english = enum_utils::conversion_table<color, std::string>{};
+  // Built from a callable. Any number of tables can coexist for the same pair of types.
+  const auto german = enum_utils::conversion_table<color, std::string>{german_name};
+
+  for (const auto c : enum_utils::range<color>{})
+    std::cout << english.convert_to_value(c) << " is " << german.convert_to_value(c) << std::endl;
+
+  if (german.convert_to_enum(std::string_view{"blau"}) == color::blue)
+    std::cout << "Tables convert both ways" << std::endl;
+
+  if (!german.try_convert_to_enum(std::string_view{"blue"}).second)
+    std::cout << "And every table knows only its own values" << std::endl;
+
+  // The keys can be normalized on lookup, without any temporary strings.
+  const auto relaxed = enum_utils::conversion_table<color, std::string, enum_utils::case_insensitive>{};
+
+  if (relaxed.convert_to_enum(std::string_view{"GREEN"}) == color::green)
+    std::cout << "Case doesn't matter for this one" << std::endl;
+
+  return 0;
+}
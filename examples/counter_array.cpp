@@ -0,0 +1,41 @@
+#include <enum_utils/counter_array.h>
+#include <enum_utils/traits.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+enum class event { received, parsed, rejected, _last = rejected };
+
+ENUM_UTILS_DEFINE_TRAITS(event, _last)
+
+
+int main(int, char*)
+{
+  auto events = enum_utils::counter_array<event>{};
+
+  // Every worker increments the counters of its own shard, so the workers don't contend for cache lines.
+  auto workers = std::vector<std::thread>{};
+
+  for (auto i = 0; i < 4; ++i)
+  {
+    workers.emplace_back([&events] {
+      for (auto j = 0; j < 1000; ++j)
+      {
+        events.increment(event::received);
+        events.increment(j % 10 == 0 ? event::rejected : event::parsed);
+      }
+    });
+  }
+
+  for (auto& worker : workers)
+    worker.join();
+
+  const auto totals = events.snapshot();
+
+  std::cout << totals[event::received] << " received, " << totals[event::parsed] << " parsed, "
+            << totals[event::rejected] << " rejected" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <enum_utils/dispatch.h>
+#include <enum_utils/mapping.h>
+#include <enum_utils/traits.h>
+
+#include <iostream>
+#include <ratio>
+
+
+enum class unit { mm, cm, m, _last = m };
+
+ENUM_UTILS_DEFINE_TRAITS(unit, _last)
+
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(unit::mm, std::milli)
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(unit::cm, std::centi)
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(unit::m,  std::ratio<1>)
+
+
+double convert(double value, unit from, unit to)
+{
+  // Both units are known at compile time inside the lambda, so the ratio is computed at compile time as well. The
+  // dispatch itself is a single indirect call rather than nested `switch` statements.
+  return enum_utils::dispatch(from, to, [value](auto f, auto t) {
+    using ratio = std::ratio_divide<
+        enum_utils::mapped_type_t<unit, decltype(f)::value>,
+        enum_utils::mapped_type_t<unit, decltype(t)::value>>;
+
+    return value * ratio::num / ratio::den;
+  });
+}
+
+
+int main(int, char*)
+{
+  std::cout << "1.5 m is " << convert(1.5, unit::m, unit::mm) << " mm" << std::endl;
+  std::cout << "42 mm is " << convert(42, unit::mm, unit::cm) << " cm" << std::endl;
+
+  // A single value works the same way.
+  enum_utils::dispatch(unit::cm, [](auto u) { std::cout << "cm is unit #" << static_cast<int>(u()) << std::endl; });
+
+  // The enumeration can be specified explicitly as well.
+  const auto u = unit::m;
+  enum_utils::dispatch<unit>(u, [](auto u) { std::cout << "m is unit #" << static_cast<int>(u()) << std::endl; });
+
+  return 0;
+}
@@ -0,0 +1,30 @@
+#include <enum_utils/histogram.h>
+#include <enum_utils/traits.h>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+enum class level : std::uint8_t { trace, debug, info, warning, error, _last = error };
+
+ENUM_UTILS_DEFINE_TRAITS(level, _last)
+
+
+int main(int, char*)
+{
+  auto levels = std::vector<level>{};
+
+  for (auto i = 0; i < 100000; ++i)
+    levels.push_back(i % 100 == 0 ? level::error : i % 3 == 0 ? level::debug : level::info);
+
+  const auto counts = enum_utils::histogram(levels);
+
+  std::cout << counts[level::info] << " info, " << counts[level::debug] << " debug, " << counts[level::error]
+            << " errors" << std::endl;
+
+  // The same, split between two threads.
+  const auto same_counts = enum_utils::histogram(levels, 2);
+
+  return same_counts == counts ? 0 : 1;
+}
@@ -16,3 +16,4 @@ static_assert(enum_utils::map_to_value<int>(diameter::d10) == 10, "OK");
 static_assert(enum_utils::try_map_to_enum<diameter>(20).first  == diameter::d20, "OK");
 static_assert(enum_utils::try_map_to_enum<diameter>(20).second == true,          "OK, successfully mapped");
 static_assert(enum_utils::try_map_to_enum<diameter>(40).second == false,         "OK, mapping failed");
+static_assert(enum_utils::map_to_enum(40, diameter::d5) == diameter::d5,          "OK, the default value");
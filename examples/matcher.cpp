@@ -0,0 +1,45 @@
+#include <enum_utils/conversion.h>
+#include <enum_utils/matcher.h>
+#include <enum_utils/traits.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+
+enum class command { get, getall, set, _last = set };
+
+ENUM_UTILS_DEFINE_TRAITS(command, _last)
+
+ENUM_UTILS_DEFINE_CONVERSION(command::get,    std::string{"GET"})
+ENUM_UTILS_DEFINE_CONVERSION(command::getall, std::string{"GETALL"})
+ENUM_UTILS_DEFINE_CONVERSION(command::set,    std::string{"SET"})
+
+
+int main(int, char*)
+{
+  // The input arrives in pieces which don't care about the boundaries of the commands.
+  const std::string_view chunks[] = {"GE", "TALL S", "ET G", "ET"};
+
+  auto matcher = enum_utils::matcher<command>{};
+
+  for (auto chunk : chunks)
+  {
+    while (!chunk.empty())
+    {
+      const auto result = matcher.feed(chunk);
+
+      if (result.status == enum_utils::match_status::matched)
+        std::cout << enum_utils::convert_to_value<std::string>(result.item) << std::endl;
+
+      // Separators (and anything else that isn't a command) are skipped.
+      chunk.remove_prefix(result.consumed > 0 ? result.consumed : 1);
+    }
+  }
+
+  // The last command can't be told from the beginning of "GETALL" until the input is over.
+  if (matcher.finish().status == enum_utils::match_status::matched)
+    std::cout << "GET, at the very end" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+#include <enum_utils/optional_array.h>
+#include <enum_utils/traits.h>
+
+#include <iostream>
+#include <string>
+
+
+enum class currency { usd, eur, gbp, jpy, chf, _last = chf };
+
+ENUM_UTILS_DEFINE_TRAITS(currency, _last)
+
+
+int main(int, char*)
+{
+  // Only some of the currencies have rates.
+  auto rates = enum_utils::optional_array<currency, double>{{currency::eur, 1.08}, {currency::gbp, 1.27}};
+
+  rates.emplace(currency::jpy, 0.0067);
+  rates.erase(currency::gbp);
+
+  std::cout << rates.size() << " rates are known" << std::endl;
+
+  // Only the items with values are visited.
+  for (auto it = rates.begin(); it != rates.end(); ++it)
+    std::cout << "currency #" << static_cast<int>(it.item()) << " costs " << *it << " USD" << std::endl;
+
+  if (!rates.contains(currency::chf))
+    std::cout << "CHF rate is unknown" << std::endl;
+
+  return 0;
+}
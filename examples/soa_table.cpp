@@ -0,0 +1,67 @@
+#include <enum_utils/soa_table.h>
+#include <enum_utils/traits.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <tuple>
+
+
+enum class message { login, order, cancel, logout, _last = logout };
+
+ENUM_UTILS_DEFINE_TRAITS(message, _last)
+
+// The columns: name, wire id, priority.
+using message_table = enum_utils::soa_table<message, std::string_view, std::uint16_t, int>;
+
+enum column { name, wire_id, priority };
+
+template <message m>
+struct message_row;
+
+template <>
+struct message_row<message::login>
+{
+  constexpr message_table::row_type operator()() const { return {"login", 0x10, 1}; }
+};
+
+template <>
+struct message_row<message::order>
+{
+  constexpr message_table::row_type operator()() const { return {"order", 0x20, 3}; }
+};
+
+template <>
+struct message_row<message::cancel>
+{
+  constexpr message_table::row_type operator()() const { return {"cancel", 0x21, 4}; }
+};
+
+template <>
+struct message_row<message::logout>
+{
+  constexpr message_table::row_type operator()() const { return {"logout", 0x11, 1}; }
+};
+
+constexpr auto messages = message_table::make<message_row>();
+
+static_assert(messages.get<wire_id>(message::cancel) == 0x21, "OK");
+static_assert(std::get<priority>(messages.row(message::order)) == 3, "OK");
+
+
+int main(int, char*)
+{
+  // A scan over a single column touches nothing else.
+  auto total_priority = 0;
+
+  for (auto p : messages.column<priority>())
+    total_priority += p;
+
+  std::cout << "total priority is " << total_priority << std::endl;
+
+  // The whole row, at once.
+  const auto [n, id, p] = messages.row(message::logout);
+  std::cout << n << " is sent as " << id << " with priority " << p << std::endl;
+
+  return 0;
+}
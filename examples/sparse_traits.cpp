@@ -0,0 +1,33 @@
+#include <enum_utils/array.h>
+#include <enum_utils/range.h>
+#include <enum_utils/sparse_traits.h>
+
+#include <cstdint>
+#include <iostream>
+
+
+// A wire protocol with explicit, sparse values.
+enum class command : std::uint16_t { hello = 100, data = 200, ack = 210, bye = 1000 };
+
+// The items are listed (in any order). Now the enumeration has exactly four items, and nothing in between.
+ENUM_UTILS_DEFINE_TRAITS_ITEMS(command, command::hello, command::data, command::ack, command::bye)
+
+static_assert(enum_utils::size<command>() == 4, "OK");
+static_assert(enum_utils::index(command::bye) == 3, "OK");
+static_assert(enum_utils::get<command>(2) == command::ack, "OK");
+
+
+int main(int, char*)
+{
+  // An element per item, not per value within [100, 1000].
+  auto received = enum_utils::array<command, int>::make();
+
+  // A value that came from the wire, known to be one of the items.
+  const auto value = std::uint16_t{210};
+  ++received[static_cast<command>(value)];
+
+  for (auto c : enum_utils::range<command>{})
+    std::cout << "command " << static_cast<int>(c) << " received " << received[c] << " times" << std::endl;
+
+  return 0;
+}
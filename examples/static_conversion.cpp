@@ -0,0 +1,19 @@
+#include <enum_utils/static_conversion.h>
+#include <enum_utils/traits.h>
+
+#include <string_view>
+
+
+enum class method { get, put, post, _last = post };
+
+ENUM_UTILS_DEFINE_TRAITS(method, _last)
+
+ENUM_UTILS_DEFINE_STATIC_CONVERSION(method::get,  std::string_view{"GET"})
+ENUM_UTILS_DEFINE_STATIC_CONVERSION(method::put,  std::string_view{"PUT"})
+ENUM_UTILS_DEFINE_STATIC_CONVERSION(method::post, std::string_view{"POST"})
+
+static_assert(enum_utils::static_convert_to_value<std::string_view>(method::put) == "PUT", "OK");
+
+// The reverse conversion works at compile time too. And it may fail, just like the runtime one.
+static_assert(enum_utils::try_static_convert_to_enum<method>(std::string_view{"POST"}).first == method::post, "OK");
+static_assert(enum_utils::try_static_convert_to_enum<method>(std::string_view{"HEAD"}).second == false,       "OK");
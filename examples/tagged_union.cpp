@@ -0,0 +1,59 @@
+#include <enum_utils/mapping.h>
+#include <enum_utils/tagged_union.h>
+#include <enum_utils/traits.h>
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+
+enum class message_kind { heartbeat, order, cancel, _last = cancel };
+
+ENUM_UTILS_DEFINE_TRAITS(message_kind, _last)
+
+struct heartbeat
+{
+  std::uint64_t timestamp;
+};
+
+struct order
+{
+  std::uint32_t id;
+  std::uint32_t quantity;
+  double        price;
+};
+
+struct cancel
+{
+  std::uint32_t id;
+};
+
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(message_kind::heartbeat, heartbeat)
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(message_kind::order,     order)
+ENUM_UTILS_DEFINE_MAPPING_TO_TYPE(message_kind::cancel,    cancel)
+
+template <message_kind k>
+using message_type = enum_utils::mapped_type_t<message_kind, k>;
+
+using message = enum_utils::tagged_union<message_kind, message_type>;
+
+// The tag takes a single byte, and the messages can be copied around as plain bytes.
+static_assert(sizeof(message) == sizeof(order) + alignof(order), "OK");
+static_assert(std::is_trivially_copyable<message>::value, "OK");
+
+
+int main(int, char*)
+{
+  auto m = message{std::integral_constant<message_kind, message_kind::order>{}, order{42, 100, 9.99}};
+
+  m.visit([](const auto& value, auto kind) {
+    std::cout << "message #" << static_cast<int>(kind()) << " of " << sizeof(value) << " bytes" << std::endl;
+  });
+
+  m.emplace<message_kind::cancel>(cancel{42});
+
+  if (auto c = m.get_if<message_kind::cancel>())
+    std::cout << "cancel order #" << c->id << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "sequence.h"
+#include "traits.h"
+
+#include <type_traits>
+#include <utility>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    template <typename E, E e, typename F, typename... Args>
+    constexpr decltype(auto) invoke_with_item(F& f, Args&&... args)
+    {
+      if constexpr (std::is_invocable<F&, Args..., std::integral_constant<E, e>>::value)
+        return f(std::forward<Args>(args)..., std::integral_constant<E, e>{});
+      else
+        return f.template operator()<e>(std::forward<Args>(args)...);
+    }
+
+    // The packs are expanded within braced initializers rather than by fold expressions: the latter nest as deep as
+    // the enumeration is large, and some compilers limit the nesting (Clang allows 256 by default). The initializers
+    // are evaluated in order, so the items are visited in order too.
+    using expander = int[];
+
+    template <typename E, typename F, E... es>
+    constexpr void for_each(F& f, sequence<E, es...>)
+    {
+      static_cast<void>(expander{0, (static_cast<void>(invoke_with_item<E, es>(f)), 0)...});
+    }
+
+    template <typename E, typename T, typename F, E... es>
+    constexpr T fold(T init, F& f, sequence<E, es...>)
+    {
+      static_cast<void>(expander{0, (static_cast<void>(init = invoke_with_item<E, es>(f, std::move(init))), 0)...});
+      return init;
+    }
+
+    template <typename E, typename F, E... es>
+    constexpr bool any_of(F& f, sequence<E, es...>)
+    {
+      auto result = false;
+      static_cast<void>(expander{0, (result = result || static_cast<bool>(invoke_with_item<E, es>(f)), 0)...});
+      return result;
+    }
+
+    template <typename E, typename F, E... es>
+    constexpr bool all_of(F& f, sequence<E, es...>)
+    {
+      auto result = true;
+      static_cast<void>(expander{0, (result = result && static_cast<bool>(invoke_with_item<E, es>(f)), 0)...});
+      return result;
+    }
+  }
+
+  /** \addtogroup traversalGroup
+   * @{
+   */
+
+  /**
+   * \brief Invokes \c f for every item of \c E, in order, with the item as a constant expression.
+   *
+   * Unlike iterating a \ref range, the loop is unrolled at compile time: \c f is invoked with
+   * <tt>std::integral_constant<E, e></tt> for each item \c e (or as <tt>f.template operator()<e>()</tt> if its call
+   * operator is a template), so the body can use the item as a template argument, say, of \ref mapped_type_t or
+   * \ref map_to_value(), and gets optimized for every item separately.
+   *
+   * \include algorithm.cpp
+   */
+  template <typename E, typename F>
+  constexpr void for_each(F&& f)
+  {
+    detail::for_each<E>(f, sequence_type<E>{});
+  }
+
+  /**
+   * \brief Folds the items of \c E from left to right, unrolled at compile time.
+   *
+   * \c f is invoked as <tt>f(accumulator, std::integral_constant<E, e>{})</tt> for each item \c e, the result is the next
+   * accumulator. The first one is \c init, the last one is returned.
+   *
+   * \sa for_each()
+   */
+  template <typename E, typename T, typename F>
+  constexpr T fold(T init, F&& f)
+  {
+    return detail::fold<E>(std::move(init), f, sequence_type<E>{});
+  }
+
+  /**
+   * \brief Tells whether \c f returns \c true for any item of \c E. Stops at the first such item.
+   *
+   * \sa for_each()
+   */
+  template <typename E, typename F>
+  constexpr bool any_of(F&& f)
+  {
+    return detail::any_of<E>(f, sequence_type<E>{});
+  }
+
+  /**
+   * \brief Tells whether \c f returns \c true for all the items of \c E. Stops at the first item it doesn't.
+   *
+   * \sa for_each()
+   */
+  template <typename E, typename F>
+  constexpr bool all_of(F&& f)
+  {
+    return detail::all_of<E>(f, sequence_type<E>{});
+  }
+
+  /** @}*/
+}
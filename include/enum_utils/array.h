@@ -36,19 +36,21 @@ namespace enum_utils
 
   namespace detail
   {
-    template <typename E, typename T, template <E> typename TGenerator, E... es>
-    auto make_array(sequence<E, es...>)
+    // Every element is initialized by a prvalue straight from its generator, and so is the array returned all the way
+    // up to the caller. Thanks to the guaranteed copy elision nothing is moved, and `T` need not be movable at all.
+    template <typename E, typename T, template <E> typename TGenerator, E... es, typename... Args>
+    constexpr auto make_array(sequence<E, es...>, Args&... args)
     {
-      return array<E, T>{TGenerator<es>{}()...};
+      return array<E, T>{TGenerator<es>{}(args...)...};
     }
 
     template <typename E>
     struct array_maker
     {
-      template <typename T, template <E> typename TGenerator>
-      static constexpr auto make_array()
+      template <typename T, template <E> typename TGenerator, typename... Args>
+      static constexpr auto make_array(Args&... args)
       {
-        return detail::make_array<E, T, TGenerator>(sequence_type<E>{});
+        return detail::make_array<E, T, TGenerator>(sequence_type<E>{}, args...);
       }
     };
 
@@ -58,7 +60,14 @@ namespace enum_utils
       template <E>
       struct impl
       {
-        constexpr T operator()() const { return T{}; }
+        template <typename... Args>
+        constexpr T operator()(Args&... args) const
+        {
+          if constexpr (sizeof...(Args) == 0)
+            return T{};
+          else
+            return T(args...);
+        }
       };
     };
   }
@@ -68,7 +77,9 @@ namespace enum_utils
    *
    * The static interface complies to \c std::array with nothing particularly interesting to it, except for
    * \ref array::make(). The function produces an instance of the class. It's capable of working at compile time
-   * as \c constexpr function.
+   * as \c constexpr function. So is the rest of the interface, except for \c fill() and \c swap().
+   *
+   * \sa static_array
    */
   template <typename E, typename T>
   struct array
@@ -95,34 +106,41 @@ namespace enum_utils
      * customized by providing your own "generator", a functor to produce every item of the array:
      *
      * \include array.cpp
+     *
+     * The arguments, if any, are passed to every generator as lvalues, so they can be known at runtime only. The
+     * default generator passes them to the constructor of \c T.
+     *
+     * The elements are constructed in place from the values returned by the generators, and the array itself is
+     * returned without a copy. So \c T may be a type that can be neither copied nor moved, such as \c std::mutex,
+     * as long as the generators return it by value.
      */
-    template <template <E> typename TGenerator = detail::simple_generator<E, T>::template impl>
-    static constexpr array make()
+    template <template <E> typename TGenerator = detail::simple_generator<E, T>::template impl, typename... Args>
+    static constexpr array make(Args&&... args)
     {
-      return detail::array_maker<E>::template make_array<T, TGenerator>();
+      return detail::array_maker<E>::template make_array<T, TGenerator>(args...);
     }
 
     void fill(const value_type& u) { _container.fill(u); }
     void swap(array& other) noexcept { _container.swap(other._container); }
 
     // Iterators.
-    iterator begin() noexcept { return _container.begin(); }
-    iterator end() noexcept { return _container.end(); }
+    constexpr iterator begin() noexcept { return _container.begin(); }
+    constexpr iterator end() noexcept { return _container.end(); }
 
-    const_iterator begin() const noexcept { return _container.begin(); }
-    const_iterator end() const noexcept { return _container.end(); }
+    constexpr const_iterator begin() const noexcept { return _container.begin(); }
+    constexpr const_iterator end() const noexcept { return _container.end(); }
 
-    reverse_iterator rbegin() noexcept { return _container.rbegin(); }
-    reverse_iterator rend() noexcept { return _container.rend(); }
+    constexpr reverse_iterator rbegin() noexcept { return _container.rbegin(); }
+    constexpr reverse_iterator rend() noexcept { return _container.rend(); }
 
-    const_reverse_iterator rbegin() const noexcept { return _container.rbegin(); }
-    const_reverse_iterator rend() const noexcept { return _container.rend(); }
+    constexpr const_reverse_iterator rbegin() const noexcept { return _container.rbegin(); }
+    constexpr const_reverse_iterator rend() const noexcept { return _container.rend(); }
 
-    const_iterator cbegin() const noexcept { return _container.cbegin(); }
-    const_iterator cend() const noexcept { return _container.cend(); }
+    constexpr const_iterator cbegin() const noexcept { return _container.cbegin(); }
+    constexpr const_iterator cend() const noexcept { return _container.cend(); }
 
-    const_reverse_iterator crbegin() const { return _container.crbegin(); }
-    const_reverse_iterator crend() const { return _container.crend(); }
+    constexpr const_reverse_iterator crbegin() const noexcept { return _container.crbegin(); }
+    constexpr const_reverse_iterator crend() const noexcept { return _container.crend(); }
 
     // Capacity.
     constexpr size_type size() const noexcept { return _container.size(); }
@@ -131,25 +149,38 @@ namespace enum_utils
     constexpr bool empty() const noexcept { return _container.empty(); }
 
     // Element access.
-    reference operator[](E e) noexcept { return _container[index(e)]; }
-    reference at(E e) { return _container.at[index(e)]; }
+    constexpr reference operator[](E e) noexcept { return _container[index(e)]; }
+    constexpr reference at(E e) { return _container.at(index(e)); }
 
     constexpr const_reference operator[](E e) const noexcept { return _container[index(e)]; }
     constexpr const_reference at(E e) const { return _container.at(index(e)); }
 
-    reference front() noexcept { return _container.front(); }
-    reference back() noexcept { return _container.back(); }
+    constexpr reference front() noexcept { return _container.front(); }
+    constexpr reference back() noexcept { return _container.back(); }
 
     constexpr const_reference front() const noexcept { return _container.front(); }
     constexpr const_reference back() const noexcept { return _container.back(); }
 
-    pointer data() noexcept { return _container.data(); }
-    const_pointer data() const noexcept { return _container.data(); }
+    constexpr pointer data() noexcept { return _container.data(); }
+    constexpr const_pointer data() const noexcept { return _container.data(); }
 
     /** \privatesection */
     container_type _container;
   };
 
+  /**
+   * \brief An array generated by \c TGenerator at compile time.
+   *
+   * It's a \c constexpr variable, so it's constant initialized and normally placed into read-only data: no code runs
+   * at startup to fill it in, no matter how many tables a program has. Every translation unit refers to the same
+   * instance. For a mutable table that still must not be initialized dynamically, declare a variable with
+   * \ref ENUM_UTILS_CONSTINIT and \ref array::make() instead.
+   *
+   * \include array.cpp
+   */
+  template <typename E, typename T, template <E> typename TGenerator>
+  inline constexpr auto static_array = array<E, T>::template make<TGenerator>();
+
   /** \relates array */
   template <typename E, typename T>
   inline bool operator==(const array<E, T>& lhs, const array<E, T>& rhs)
@@ -194,3 +225,26 @@ namespace enum_utils
 
   /** @}*/
 }
+
+/** \addtogroup containersGroup
+ *  @{
+ */
+
+/**
+ * \brief Requires a variable to be constant initialized, such as an array produced by \ref enum_utils::array::make().
+ *
+ * It's \c constinit where the compiler supports it (or an equivalent extension), and nothing otherwise. Unlike
+ * \c constexpr, the variable stays mutable, but the compiler rejects it if the initializer can't be evaluated at compile
+ * time. So no table is silently filled in by a dynamic initializer at startup.
+ */
+#if defined(__cpp_constinit)
+#define ENUM_UTILS_CONSTINIT constinit
+#elif defined(__clang__)
+#define ENUM_UTILS_CONSTINIT [[clang::require_constant_initialization]]
+#elif defined(__GNUC__) && __GNUC__ >= 10
+#define ENUM_UTILS_CONSTINIT __constinit
+#else
+#define ENUM_UTILS_CONSTINIT
+#endif
+
+/** @}*/
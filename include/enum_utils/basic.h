@@ -20,6 +20,10 @@
 
 #include "traits.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
 
 namespace enum_utils
 {
@@ -30,13 +34,18 @@ namespace enum_utils
   /**
    * \brief Returns an index of the enum value passed as the function argument.
    *
-   * The index is obtained in O(1). It's assumed that \c e is within the bounds.
+   * The index is obtained in O(1). It's assumed that \c e is within the bounds (or is one of the items, if the
+   * enumeration has gaps).
    */
   template <typename E>
   constexpr std::size_t index(E e) noexcept
   {
     using underlying_type = typename traits<E>::underlying_type;
-    return static_cast<std::size_t>(static_cast<underlying_type>(e) - static_cast<underlying_type>(traits<E>::first));
+
+    if constexpr (detail::is_sparse<E>::value)
+      return traits<E>::index(e);
+    else
+      return static_cast<std::size_t>(static_cast<underlying_type>(e) - static_cast<underlying_type>(traits<E>::first));
   }
 
   /**
@@ -70,7 +79,11 @@ namespace enum_utils
   constexpr E get(std::size_t ind) noexcept
   {
     using underlying_type = typename traits<E>::underlying_type;
-    return static_cast<E>(static_cast<underlying_type>(traits<E>::first) + ind);
+
+    if constexpr (detail::is_sparse<E>::value)
+      return traits<E>::items[ind];
+    else
+      return static_cast<E>(static_cast<underlying_type>(traits<E>::first) + ind);
   }
 
   /**
@@ -88,6 +101,19 @@ namespace enum_utils
 
   /** @}*/
 
+  namespace detail
+  {
+    // The smallest unsigned type capable of holding `max`. Handy for indices and tags stored in bulk.
+    template <std::size_t max>
+    using smallest_unsigned_t = std::conditional_t<
+        max <= UINT8_MAX,
+        std::uint8_t,
+        std::conditional_t<
+            max <= UINT16_MAX,
+            std::uint16_t,
+            std::conditional_t<max <= UINT32_MAX, std::uint32_t, std::uint64_t>>>;
+  }
+
   /** \addtogroup traversalGroup
   *  @{
   */
@@ -0,0 +1,64 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cstddef>
+#include <cstdint>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // Bit manipulation on 64-bit words. The builtins are constant expressions on GCC and Clang, the rest of compilers
+    // get portable (and still branchless) equivalents. So does `popcount` unless the target has the instruction: the
+    // builtin would be a library call then, which is slower than the inlined equivalent.
+
+    constexpr std::size_t word_bits = 64;
+
+    constexpr std::size_t popcount(std::uint64_t word) noexcept
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__POPCNT__)
+      return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+      word = word - ((word >> 1) & 0x5555555555555555ull);
+      word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+      word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+      return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    // The number of trailing zero bits. The word must not be zero.
+    constexpr std::size_t countr_zero(std::uint64_t word) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+      return popcount((word & (0 - word)) - 1);
+#endif
+    }
+
+    // The word with `count` lowest bits set, `count` is within [0, 64].
+    constexpr std::uint64_t low_bits(std::size_t count) noexcept
+    {
+      return count < word_bits ? (std::uint64_t{1} << count) - 1 : ~std::uint64_t{0};
+    }
+
+    constexpr std::size_t word_count(std::size_t bits) noexcept { return (bits + word_bits - 1) / word_bits; }
+  }
+}
@@ -0,0 +1,379 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "array.h"
+#include "basic.h"
+#include "bits.h"
+#include "range.h"
+#include "traits.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+
+namespace enum_utils
+{
+  /** \addtogroup containersGroup
+   * @{
+   */
+
+  /**
+   * \brief A compact set of items of \c E, a bit per item.
+   *
+   * It's what <tt>\ref array<E, bool></tt> is, but eight times smaller. The bits are packed into 64-bit words, so the
+   * set algebra (union, intersection, difference) handles 64 items at a time, and the loops over the words are plain
+   * enough for compilers to vectorize them on large enums. The iteration visits the set items only, skipping the
+   * rest a word at a time.
+   *
+   * Everything but the construction from iterators is \c constexpr.
+   *
+   * \include bitset.cpp
+   * \sa masked_fill()
+   * \sa masked_copy()
+   */
+  template <typename E>
+  class bitset : validator<E>
+  {
+  public:
+    using word_type = std::uint64_t;
+
+    /**
+     * \brief The number of words the bits are packed into.
+     */
+    static constexpr std::size_t word_count = detail::word_count(size<E>());
+
+    /**
+     * \brief A forward iterator over the set items, in order.
+     */
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = E;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const E*;
+      using reference         = E;
+
+      constexpr const_iterator() noexcept = default;
+
+      constexpr E operator*() const noexcept { return get<E>(_word * detail::word_bits + detail::countr_zero(_bits)); }
+
+      constexpr const_iterator& operator++() noexcept
+      {
+        _bits &= _bits - 1;
+        skip_empty();
+        return *this;
+      }
+
+      constexpr const_iterator operator++(int) noexcept
+      {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+      }
+
+      constexpr bool operator==(const const_iterator& other) const noexcept
+      {
+        return _word == other._word && _bits == other._bits;
+      }
+
+      constexpr bool operator!=(const const_iterator& other) const noexcept { return !(*this == other); }
+
+    private:
+      friend class bitset;
+
+      constexpr const_iterator(const word_type* words, std::size_t word) noexcept :
+        _words(words),
+        _word(word),
+        _bits(word < word_count ? words[word] : 0)
+      {
+        skip_empty();
+      }
+
+      constexpr void skip_empty() noexcept
+      {
+        while (_bits == 0 && _word < word_count)
+        {
+          if (++_word < word_count)
+            _bits = _words[_word];
+        }
+      }
+
+      const word_type* _words = nullptr;
+      std::size_t _word       = word_count;
+      word_type _bits         = 0;
+    };
+
+    using iterator = const_iterator;
+
+    /**
+     * \brief Constructs an empty set.
+     */
+    constexpr bitset() noexcept = default;
+
+    /**
+     * \brief Constructs a set of the listed items.
+     */
+    constexpr bitset(std::initializer_list<E> items) noexcept
+    {
+      for (auto e : items)
+        set(e);
+    }
+
+    /**
+     * \brief Constructs a set of the items within the range, a word at a time.
+     */
+    constexpr explicit bitset(const range<E>& items) noexcept
+    {
+      const auto first = index(items._first);
+      const auto last  = index(items._last) + 1;
+
+      for (auto i = first / detail::word_bits; i < detail::word_count(last); ++i)
+      {
+        const auto begin = i * detail::word_bits;
+        const auto low   = first > begin ? first - begin : 0;
+        const auto high  = last - begin < detail::word_bits ? last - begin : detail::word_bits;
+
+        _words[i] = detail::low_bits(high) & ~detail::low_bits(low);
+      }
+    }
+
+    /**
+     * \brief Constructs a set of the items \c flags are \c true for.
+     */
+    constexpr explicit bitset(const array<E, bool>& flags) noexcept
+    {
+      for (std::size_t i = 0; i < flags.size(); ++i)
+        _words[i / detail::word_bits] |= word_type{flags.data()[i]} << (i % detail::word_bits);
+    }
+
+    /**
+     * \brief Constructs a set of the items within <tt>[first, last)</tt>.
+     */
+    template <typename InputIt>
+    bitset(InputIt first, InputIt last)
+    {
+      for (; first != last; ++first)
+        set(*first);
+    }
+
+    /**
+     * \brief Returns the set of all the items.
+     */
+    static constexpr bitset all_items() noexcept { return bitset{}.set(); }
+
+    // Element access.
+    constexpr bool test(E e) const noexcept { return (_words[word(e)] >> bit(e)) & 1; }
+    constexpr bool operator[](E e) const noexcept { return test(e); }
+
+    // Modifiers.
+    constexpr bitset& set(E e, bool value = true) noexcept
+    {
+      _words[word(e)] = (_words[word(e)] & ~mask(e)) | (word_type{value} << bit(e));
+      return *this;
+    }
+
+    constexpr bitset& reset(E e) noexcept
+    {
+      _words[word(e)] &= ~mask(e);
+      return *this;
+    }
+
+    constexpr bitset& flip(E e) noexcept
+    {
+      _words[word(e)] ^= mask(e);
+      return *this;
+    }
+
+    constexpr bitset& set() noexcept
+    {
+      for (auto& w : _words)
+        w = ~word_type{0};
+
+      return trim();
+    }
+
+    constexpr bitset& reset() noexcept
+    {
+      for (auto& w : _words)
+        w = 0;
+
+      return *this;
+    }
+
+    constexpr bitset& flip() noexcept
+    {
+      for (auto& w : _words)
+        w = ~w;
+
+      return trim();
+    }
+
+    // Set algebra.
+    constexpr bitset& operator|=(const bitset& other) noexcept
+    {
+      for (std::size_t i = 0; i < word_count; ++i)
+        _words[i] |= other._words[i];
+
+      return *this;
+    }
+
+    constexpr bitset& operator&=(const bitset& other) noexcept
+    {
+      for (std::size_t i = 0; i < word_count; ++i)
+        _words[i] &= other._words[i];
+
+      return *this;
+    }
+
+    constexpr bitset& operator^=(const bitset& other) noexcept
+    {
+      for (std::size_t i = 0; i < word_count; ++i)
+        _words[i] ^= other._words[i];
+
+      return *this;
+    }
+
+    /**
+     * \brief Removes the items of \c other from the set.
+     */
+    constexpr bitset& operator-=(const bitset& other) noexcept
+    {
+      for (std::size_t i = 0; i < word_count; ++i)
+        _words[i] &= ~other._words[i];
+
+      return *this;
+    }
+
+    constexpr bitset operator~() const noexcept { return bitset{*this}.flip(); }
+
+    // Queries.
+    constexpr std::size_t count() const noexcept
+    {
+      auto result = std::size_t{0};
+
+      for (auto w : _words)
+        result += detail::popcount(w);
+
+      return result;
+    }
+
+    constexpr bool any() const noexcept { return !none(); }
+    constexpr bool all() const noexcept { return count() == size(); }
+
+    constexpr bool none() const noexcept
+    {
+      auto result = word_type{0};
+
+      for (auto w : _words)
+        result |= w;
+
+      return result == 0;
+    }
+
+    /**
+     * \brief Checks whether all the items of the set belong to \c other as well.
+     */
+    constexpr bool is_subset_of(const bitset& other) const noexcept
+    {
+      auto result = word_type{0};
+
+      for (std::size_t i = 0; i < word_count; ++i)
+        result |= _words[i] & ~other._words[i];
+
+      return result == 0;
+    }
+
+    /**
+     * \brief Returns the number of the items of \c E (not the number of the set ones, see \ref count() for that).
+     */
+    static constexpr std::size_t size() noexcept { return enum_utils::size<E>(); }
+
+    // Iterators.
+    constexpr const_iterator begin() const noexcept { return const_iterator{_words, 0}; }
+    constexpr const_iterator end() const noexcept { return const_iterator{_words, word_count}; }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * \brief Returns the words the bits are packed into. The bits past the last item are always zero.
+     */
+    constexpr const word_type* data() const noexcept { return _words; }
+
+    friend constexpr bool operator==(const bitset& lhs, const bitset& rhs) noexcept
+    {
+      auto result = word_type{0};
+
+      for (std::size_t i = 0; i < word_count; ++i)
+        result |= lhs._words[i] ^ rhs._words[i];
+
+      return result == 0;
+    }
+
+    friend constexpr bool operator!=(const bitset& lhs, const bitset& rhs) noexcept { return !(lhs == rhs); }
+
+    friend constexpr bitset operator|(bitset lhs, const bitset& rhs) noexcept { return lhs |= rhs; }
+    friend constexpr bitset operator&(bitset lhs, const bitset& rhs) noexcept { return lhs &= rhs; }
+    friend constexpr bitset operator^(bitset lhs, const bitset& rhs) noexcept { return lhs ^= rhs; }
+    friend constexpr bitset operator-(bitset lhs, const bitset& rhs) noexcept { return lhs -= rhs; }
+
+  private:
+    static constexpr std::size_t word(E e) noexcept { return index(e) / detail::word_bits; }
+    static constexpr std::size_t bit(E e) noexcept { return index(e) % detail::word_bits; }
+    static constexpr word_type mask(E e) noexcept { return word_type{1} << bit(e); }
+
+    // Clears the bits past the last item, so that they never affect counting and comparison.
+    constexpr bitset& trim() noexcept
+    {
+      _words[word_count - 1] &= detail::low_bits(size() - (word_count - 1) * detail::word_bits);
+      return *this;
+    }
+
+    word_type _words[word_count] = {};
+  };
+
+  /**
+   * \brief Assigns \c value to the elements of \c a whose items belong to \c mask.
+   *
+   * \relates bitset
+   */
+  template <typename E, typename T>
+  constexpr void masked_fill(array<E, T>& a, const bitset<E>& mask, const T& value)
+  {
+    for (auto e : mask)
+      a[e] = value;
+  }
+
+  /**
+   * \brief Copies the elements of \c from whose items belong to \c mask to the respective elements of \c to.
+   *
+   * \relates bitset
+   */
+  template <typename E, typename T>
+  constexpr void masked_copy(const array<E, T>& from, array<E, T>& to, const bitset<E>& mask)
+  {
+    for (auto e : mask)
+      to[e] = from[e];
+  }
+
+  /** @}*/
+}
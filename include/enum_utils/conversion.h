@@ -20,12 +20,23 @@
 
 #include "array.h"
 #include "exceptions.h"
+#include "lookup.h"
+#include "normalization.h"
 #include "range.h"
+#include "sequence.h"
 #include "traits.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <type_traits>
-#include <unordered_map>
+#include <utility>
 
 
 namespace enum_utils
@@ -36,22 +47,6 @@ namespace enum_utils
 
   namespace detail
   {
-    template <typename E, typename T>
-    auto make_reverse_lookup_table()
-    {
-      auto result = std::unordered_map<T, E>{};
-
-      for (const auto e : range<E>{})
-      {
-        const auto is_duplicate = !result.try_emplace(convert_to_value<T>(e), e).second;
-
-        if (is_duplicate)
-          throw bad_conversion{"Ambiguous reverse conversion (multiple enum entries match the same value)"};
-      }
-
-      return result;
-    }
-
     template <typename E, E e, typename T>
     T convert();
   }
@@ -73,41 +68,450 @@ namespace enum_utils
     };
   };
 
+  namespace detail
+  {
+    template <typename T, typename = void>
+    struct is_hashable : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_hashable<T, std::enable_if_t<std::is_default_constructible<std::hash<T>>::value>> : std::true_type
+    {
+    };
+
+    template <typename E, typename T, typename F, E... es>
+    array<E, T> make_array_from_callable(F& f, sequence<E, es...>)
+    {
+      return array<E, T>{f(es)...};
+    }
+
+    // Holds a reverse lookup table which is built on first use, so neither hashing nor comparison of the values is
+    // involved until someone actually converts back. Once built, the table is published through an atomic pointer,
+    // so a table shared between threads is built only once. Copies don't share the built table but build their own
+    // one when needed. The table itself, not only its contents, is allocated with `Allocator`.
+    template <typename E, typename T, typename Policy, typename Allocator>
+    class lazy_reverse_lookup_table
+    {
+    public:
+      using table_type = reverse_lookup_table<E, T, Policy, Allocator>;
+
+      explicit lazy_reverse_lookup_table(const Allocator& allocator) : _allocator(allocator) {}
+
+      lazy_reverse_lookup_table(const lazy_reverse_lookup_table& other) : _allocator(other._allocator) {}
+
+      lazy_reverse_lookup_table(lazy_reverse_lookup_table&& other) noexcept :
+        _allocator(other._allocator), _table(other._table.exchange(nullptr, std::memory_order_acq_rel)),
+        _construction_time(other._construction_time)
+      {
+      }
+
+      ~lazy_reverse_lookup_table() { destroy(_table.load(std::memory_order_acquire)); }
+
+      lazy_reverse_lookup_table& operator=(const lazy_reverse_lookup_table& other)
+      {
+        if (this != &other)
+          reset(other._allocator, nullptr, std::chrono::nanoseconds{});
+
+        return *this;
+      }
+
+      lazy_reverse_lookup_table& operator=(lazy_reverse_lookup_table&& other) noexcept
+      {
+        if (this != &other)
+        {
+          reset(other._allocator, other._table.exchange(nullptr, std::memory_order_acq_rel),
+              other._construction_time);
+        }
+
+        return *this;
+      }
+
+      const table_type& get(const array<E, T>& values) const
+      {
+        if (const auto table = _table.load(std::memory_order_acquire))
+          return *table;
+
+        auto lock = std::lock_guard<std::mutex>{_mutex};
+
+        if (const auto table = _table.load(std::memory_order_relaxed))
+          return *table;
+
+        const auto start     = std::chrono::steady_clock::now();
+        auto       allocator = table_allocator{_allocator};
+        const auto table     = table_allocator_traits::allocate(allocator, 1);
+
+        try
+        {
+          table_allocator_traits::construct(allocator, table, values, _allocator);
+        }
+        catch (...)
+        {
+          table_allocator_traits::deallocate(allocator, table, 1);
+          throw;
+        }
+
+        _construction_time = std::chrono::steady_clock::now() - start;
+        _table.store(table, std::memory_order_release);
+        return *table;
+      }
+
+      // Only meaningful after `get()`.
+      std::chrono::nanoseconds construction_time() const noexcept { return _construction_time; }
+
+    private:
+      using table_allocator        = typename std::allocator_traits<Allocator>::template rebind_alloc<table_type>;
+      using table_allocator_traits = std::allocator_traits<table_allocator>;
+
+      // The table has to be released with the allocator it was allocated with, so before `_allocator` changes.
+      void reset(const Allocator& allocator, const table_type* table, std::chrono::nanoseconds time) noexcept
+      {
+        destroy(_table.exchange(table, std::memory_order_acq_rel));
+        _allocator         = allocator;
+        _construction_time = time;
+      }
+
+      void destroy(const table_type* table) const noexcept
+      {
+        if (!table)
+          return;
+
+        auto       allocator = table_allocator{_allocator};
+        const auto p         = const_cast<table_type*>(table);
+
+        table_allocator_traits::destroy(allocator, p);
+        table_allocator_traits::deallocate(allocator, p, 1);
+      }
+
+      Allocator                              _allocator;
+      mutable std::atomic<const table_type*> _table{nullptr};
+      mutable std::chrono::nanoseconds       _construction_time{};
+      mutable std::mutex                     _mutex;
+    };
+  }
+
+  /**
+   * \brief A table to convert items of \c E to values of type \c T and back at runtime.
+   *
+   * It's what \ref convert_to_value() and \ref convert_to_enum() are built upon, except that those use a single
+   * implicit instance of the table per pair of \c E and \c T. Having a table of your own allows you to have several
+   * tables for the same pair (say, for different locales or different versions of a protocol), to pass them around
+   * explicitly, and to control where the reverse lookup table allocates its memory via \c Allocator.
+   *
+   * The values are produced either by a generator (\ref conversion_generator by default), or by a callable which
+   * accepts an item of \c E and returns the corresponding value of type \c T. The reverse lookup table is built on the
+   * first reverse conversion (or by \ref preload()), so a table used only to convert to values never hashes or compares
+   * them. The reverse conversion is available only if \c T is hashable.
+   *
+   * The reverse conversion matches keys to values according to the normalization \c Policy (see \ref exact_match). The
+   * values are normalized once, when the table is built, while the keys are normalized on the fly during hashing and
+   * comparison, so no temporary strings are involved. The values returned by the forward conversion are intact.
+   *
+   * \include conversion_table.cpp
+   *
+   * \sa convert_to_value()
+   * \sa convert_to_enum()
+   */
+  template <typename E, typename T, typename Policy = exact_match, typename Allocator = std::allocator<T>>
+  class conversion_table : validator<E>
+  {
+    static_assert(detail::is_normalization_policy<Policy>::value, "Policy is not a normalization policy.");
+
+  public:
+    using policy_type    = Policy;
+    using allocator_type = Allocator;
+
+    /**
+     * \brief Builds the table using \ref conversion_generator.
+     */
+    explicit conversion_table(const Allocator& allocator = Allocator{}) :
+      conversion_table(array<E, T>::template make<conversion_generator<E, T>::template impl>(), allocator)
+    {
+    }
+
+    /**
+     * \brief Builds the table from an array of values.
+     */
+    explicit conversion_table(array<E, T> values, const Allocator& allocator = Allocator{}) :
+      _values(std::move(values)), _reverse_lookup_table(allocator)
+    {
+    }
+
+    /**
+     * \brief Builds the table using a callable which converts each item of \c E to a value of type \c T.
+     */
+    template <typename F, typename = std::enable_if_t<std::is_invocable_r<T, F&, E>::value>>
+    explicit conversion_table(F f, const Allocator& allocator = Allocator{}) :
+      conversion_table(detail::make_array_from_callable<E, T>(f, sequence_type<E>{}), allocator)
+    {
+    }
+
+    /**
+     * \brief Builds the table using a generator in the same way \ref array::make() does.
+     */
+    template <template <E> typename TGenerator>
+    static conversion_table make(const Allocator& allocator = Allocator{})
+    {
+      return conversion_table{array<E, T>::template make<TGenerator>(), allocator};
+    }
+
+    /**
+     * \brief Returns all the values.
+     */
+    const array<E, T>& values() const noexcept { return _values; }
+
+    /**
+     * \brief Converts the passed enum value to the corresponding value of type \c T.
+     *
+     * \sa enum_utils::convert_to_value()
+     */
+    const T& convert_to_value(E e) const noexcept { return _values[e]; }
+
+    /**
+     * \brief Converts \c count enum values to the corresponding values of type \c T at once.
+     *
+     * \sa enum_utils::convert_to_value()
+     */
+    template <typename OutputIt>
+    OutputIt convert_to_value(const E* items, std::size_t count, OutputIt out) const
+    {
+      for (std::size_t i = 0; i < count; ++i, ++out)
+        *out = _values[items[i]];
+
+      return out;
+    }
+
+    /**
+     * \brief Tells whether more than one item match the same value (after normalization).
+     *
+     * The reverse conversion always fails for an ambiguous table.
+     */
+    bool is_ambiguous() const { return reverse_lookup().is_ambiguous(); }
+
+    /**
+     * \brief Builds the reverse lookup table now rather than on the first reverse conversion.
+     *
+     * \returns The time it took to build the reverse lookup table, no matter whether it was this call or some earlier
+     * reverse conversion that actually built it.
+     * \sa enum_utils::preload()
+     */
+    std::chrono::nanoseconds preload() const
+    {
+      static_assert(detail::is_hashable<T>::value, "The reverse conversion requires `std::hash` for the values.");
+
+      reverse_lookup();
+      return _reverse_lookup_table.construction_time();
+    }
+
+    /**
+     * \brief Tries to convert a passed key back to the corresponding enum value.
+     *
+     * The key is either a value of type \c T or something it can be looked up by (like a string view for strings).
+     *
+     * \sa enum_utils::try_convert_to_enum()
+     */
+    template <typename K>
+    std::pair<E, bool> try_convert_to_enum(const K& key) const
+    {
+      static_assert(detail::is_hashable<T>::value, "The reverse conversion requires `std::hash` for the values.");
+
+      const auto& table = reverse_lookup();
+      const auto  item  = table.find(key);
+
+      if (!item || table.is_ambiguous())
+        return std::make_pair(traits<E>::first, false);
+
+      return std::make_pair(*item, true);
+    }
+
+    /**
+     * \brief Tries to convert \c count keys back to the corresponding enum values at once.
+     *
+     * \sa enum_utils::try_convert_to_enum()
+     */
+    template <typename K>
+    std::size_t try_convert_to_enum(const K* keys, std::size_t count, E* items, bool* found) const
+    {
+      static_assert(detail::is_hashable<T>::value, "The reverse conversion requires `std::hash` for the values.");
+
+      const auto& table = reverse_lookup();
+
+      if (table.is_ambiguous())
+      {
+        std::fill(items, items + count, traits<E>::first);
+        std::fill(found, found + count, false);
+        return 0;
+      }
+
+      return table.find(keys, count, items, found, traits<E>::first);
+    }
+
+    /**
+     * \brief Converts a passed key back to the corresponding enum value.
+     *
+     * \throws bad_conversion
+     * \sa enum_utils::convert_to_enum()
+     */
+    template <typename K>
+    E convert_to_enum(const K& key) const
+    {
+      const auto result = try_convert_to_enum(key);
+
+      if (!result.second)
+      {
+        if (is_ambiguous())
+          throw bad_conversion{"Ambiguous reverse conversion (multiple enum entries match the same value)"};
+
+        throw bad_conversion{"No enum value matches the key"};
+      }
+
+      return result.first;
+    }
+
+    /**
+     * \brief Converts a passed key either back to the corresponding enum value or to a passed default value.
+     *
+     * \sa enum_utils::convert_to_enum()
+     */
+    template <typename K>
+    E convert_to_enum(const K& key, E default_value) const
+    {
+      const auto result = try_convert_to_enum(key);
+      return result.second ? result.first : default_value;
+    }
+
+  private:
+    using reverse_lookup_table = detail::lazy_reverse_lookup_table<E, T, Policy, Allocator>;
+
+    const typename reverse_lookup_table::table_type& reverse_lookup() const
+    {
+      return _reverse_lookup_table.get(_values);
+    }
+
+    array<E, T>          _values;
+    reverse_lookup_table _reverse_lookup_table;
+  };
+
+  namespace detail
+  {
+    // The default tables are built behind function-local statics only once. After that they're published through
+    // plain pointers, so the steady-state access involves no initialization guard (an acquire load is a plain load on
+    // most platforms).
+    template <typename E, typename T, typename Policy = exact_match>
+    struct conversion_storage
+    {
+      static inline std::atomic<const conversion_table<E, T, Policy>*> table{nullptr};
+      static inline std::atomic<std::chrono::nanoseconds::rep> construction_time{0};
+    };
+
+    template <typename E, typename T, typename Policy>
+    const conversion_table<E, T, Policy>& make_default_conversion_table()
+    {
+      static const auto table = [] {
+        const auto start  = std::chrono::steady_clock::now();
+        auto       result = conversion_table<E, T, Policy>{};
+        const auto end    = std::chrono::steady_clock::now();
+
+        conversion_storage<E, T, Policy>::construction_time.store(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+        return result;
+      }();
+
+      conversion_storage<E, T, Policy>::table.store(&table, std::memory_order_release);
+      return table;
+    }
+
+    template <typename E, typename T, typename Policy = exact_match>
+    const conversion_table<E, T, Policy>& default_conversion_table()
+    {
+      const auto table = conversion_storage<E, T, Policy>::table.load(std::memory_order_acquire);
+      return table ? *table : make_default_conversion_table<E, T, Policy>();
+    }
+
+    template <typename Policy, typename R = void>
+    using enable_if_policy_t = std::enable_if_t<is_normalization_policy<Policy>::value, R>;
+  }
+
   /**
    * \brief Converts the passed enum value to the corresponding value of type \c T.
    *
-   * Uses \ref conversion_generator on first invocation and remembers the result. The reverse conversion is also
-   * possible.
+   * Uses \ref conversion_generator on first invocation and remembers the result in the default
+   * \ref conversion_table for \c E and \c T. The reverse conversion is also possible.
    * \sa conversion_generator
    * \sa convert_to_enum()
    */
   template <typename T, typename E>
   const T& convert_to_value(E e)
   {
-    static const auto values = enum_utils::array<E, T>::make<conversion_generator<E, T>::template impl>();
-    return values[e];
+    return detail::default_conversion_table<E, T>().convert_to_value(e);
+  }
+
+  /**
+   * \brief Converts \c count enum values to the corresponding values of type \c T at once.
+   *
+   * Essentially same as invoking the other overload for every item, but the conversion table is accessed only once per
+   * batch. The converted values are assigned to \c out one after another, just like \c std::transform does.
+   *
+   * \returns The output iterator past the last converted value.
+   * \sa convert_to_value()
+   */
+  template <typename T, typename E, typename OutputIt>
+  OutputIt convert_to_value(const E* items, std::size_t count, OutputIt out)
+  {
+    return detail::default_conversion_table<E, T>().convert_to_value(items, count, out);
+  }
+
+  /**
+   * \brief Tries to convert a passed value of type \c T back to the corresponding enum value.
+   *
+   * This is the core of the reverse conversion. It never throws \ref bad_conversion, so a failed conversion costs no
+   * more than a successful one. The conversion fails if either no enum item matches the provided value or more than one
+   * item match the same value (not necessarily the provided one, any value whatsoever).
+   *
+   * String views (\c std::string_view, \c std::wstring_view, etc.) are looked up among the values of the corresponding
+   * string type (\c std::string, \c std::wstring, etc.) as is, no temporary string is ever allocated.
+   *
+   * \returns \c std::pair<E, true> on successful conversion or \c std::pair<_first, false> otherwise.
+   * \sa convert_to_enum()
+   * \sa convert_to_value()
+   */
+  template <typename E, typename T>
+  std::pair<E, bool> try_convert_to_enum(const T& t)
+  {
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>>().try_convert_to_enum(t);
+  }
+
+  /**
+   * \brief Tries to convert \c count values of type \c T back to the corresponding enum values at once.
+   *
+   * Essentially same as invoking the other overload for every key, but the reverse lookup table is accessed only once
+   * per batch, and lookups of neighbouring keys overlap in memory. The outcome for the i-th key is written to
+   * \c items[i] and \c found[i], the latter telling whether the conversion succeeded.
+   *
+   * \returns The number of successfully converted values.
+   * \sa try_convert_to_enum()
+   */
+  template <typename E, typename T>
+  std::size_t try_convert_to_enum(const T* keys, std::size_t count, E* items, bool* found)
+  {
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>>().try_convert_to_enum(
+        keys, count, items, found);
   }
 
   /**
    * \brief Converts a passed value of type \c T back to the corresponding enum value.
    *
-   * The \ref bad_conversion is thrown if either no enum item matches the provided value or more than one item match
-   * the same value (not necessarily the provided one, any value whatsoever).
+   * Essentially same as \ref try_convert_to_enum(), but it always either returns a value of \c E, or throws
+   * \ref bad_conversion if it failed to find one.
    *
    * \throws bad_conversion
+   * \sa try_convert_to_enum()
    * \sa convert_to_value()
    */
   template <typename E, typename T>
   E convert_to_enum(const T& t)
   {
-    static const auto reverse_lookup_table = detail::make_reverse_lookup_table<E, T>();
-
-    const auto it = reverse_lookup_table.find(t);
-
-    if (it == reverse_lookup_table.cend())
-      throw bad_conversion{"No enum value matches the key"};
-
-    return it->second;
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>>().convert_to_enum(t);
   }
 
   /**
@@ -115,19 +519,96 @@ namespace enum_utils
    *
    * Essentially same as the other overload, but never throws \ref bad_conversion. Instead it returns passed
    * \c default_value on any conversion failure.
+   * \sa try_convert_to_enum()
    * \sa convert_to_value()
    */
   template <typename E, typename T>
   E convert_to_enum(const T& t, E default_value)
   {
-    try
-    {
-      return convert_to_enum<E>(t);
-    }
-    catch (bad_conversion&)
-    {
-      return default_value;
-    }
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>>().convert_to_enum(t, default_value);
+  }
+
+  /**
+   * \brief Tries to convert a passed value of type \c T back to the corresponding enum value, normalizing it first.
+   *
+   * Essentially same as the other overload, but the value and the values it's matched against are normalized according
+   * to \c Policy. For instance, \ref case_insensitive matches \c "content-type" against \c "Content-Type". The
+   * normalized values are computed once per \c Policy, and the passed value is normalized on the fly, so there's
+   * no need to lowercase it into a temporary string beforehand.
+   *
+   * The conversion also fails if several items match the same value after normalization.
+   *
+   * \sa exact_match
+   * \sa case_insensitive
+   * \sa case_and_separator_insensitive
+   */
+  template <typename E, typename T, typename Policy>
+  detail::enable_if_policy_t<Policy, std::pair<E, bool>> try_convert_to_enum(const T& t, Policy)
+  {
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>, Policy>().try_convert_to_enum(t);
+  }
+
+  /**
+   * \brief Converts a passed value of type \c T back to the corresponding enum value, normalizing it first.
+   *
+   * \throws bad_conversion
+   * \sa try_convert_to_enum(const T&, Policy)
+   */
+  template <typename E, typename T, typename Policy>
+  detail::enable_if_policy_t<Policy, E> convert_to_enum(const T& t, Policy)
+  {
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>, Policy>().convert_to_enum(t);
+  }
+
+  /**
+   * \brief Converts a passed value of type \c T either back to the corresponding enum value or to a passed default
+   * value, normalizing it first.
+   *
+   * \sa try_convert_to_enum(const T&, Policy)
+   */
+  template <typename E, typename T, typename Policy>
+  detail::enable_if_policy_t<Policy, E> convert_to_enum(const T& t, E default_value, Policy)
+  {
+    return detail::default_conversion_table<E, detail::lookup_value_t<T>, Policy>().convert_to_enum(t, default_value);
+  }
+
+  /**
+   * \brief Tries to convert a passed string of \c length characters back to the corresponding enum value.
+   *
+   * Essentially same as the other overload invoked with a string view. The string doesn't need to be null-terminated.
+   * \sa try_convert_to_enum()
+   */
+  template <typename E, typename C>
+  std::pair<E, bool> try_convert_to_enum(const C* s, std::size_t length)
+  {
+    return try_convert_to_enum<E>(std::basic_string_view<C>{s, length});
+  }
+
+  /**
+   * \brief Converts a passed string of \c length characters back to the corresponding enum value.
+   *
+   * Essentially same as the other overload invoked with a string view. The string doesn't need to be null-terminated.
+   *
+   * \throws bad_conversion
+   * \sa convert_to_enum()
+   */
+  template <typename E, typename C>
+  E convert_to_enum(const C* s, std::size_t length)
+  {
+    return convert_to_enum<E>(std::basic_string_view<C>{s, length});
+  }
+
+  /**
+   * \brief Converts a passed string of \c length characters either back to the corresponding enum value or to a passed
+   * default value.
+   *
+   * Essentially same as the other overload invoked with a string view. The string doesn't need to be null-terminated.
+   * \sa convert_to_enum()
+   */
+  template <typename E, typename C>
+  E convert_to_enum(const C* s, std::size_t length, E default_value)
+  {
+    return convert_to_enum(std::basic_string_view<C>{s, length}, default_value);
   }
 
   /** @}*/
@@ -0,0 +1,163 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "array.h"
+#include "basic.h"
+#include "traits.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // The size of a cache line on most contemporary hardware. `std::hardware_destructive_interference_size` is
+    // the same thing, but it's missing from some of the standard libraries and triggers warnings in others.
+    constexpr std::size_t cache_line_size = 64;
+
+    // Every thread gets a number of its own on the first use, in the order of arrival. Counter arrays map the number
+    // onto their shards, so that threads keep hitting the same shards.
+    inline std::size_t thread_shard_index() noexcept
+    {
+      static std::atomic<std::size_t> next_index{0};
+      thread_local const auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+      return index;
+    }
+
+    constexpr std::size_t round_up_to_power_of_two(std::size_t value) noexcept
+    {
+      auto result = std::size_t{1};
+
+      while (result < value)
+        result *= 2;
+
+      return result;
+    }
+  }
+
+  /** \addtogroup containersGroup
+   * @{
+   */
+
+  /**
+   * \brief An array of event counters indexed by enumerations, which many threads can increment at once.
+   *
+   * An <tt>\ref array<E, std::atomic<std::uint64_t>></tt> does the job too, but it packs eight counters into each
+   * cache line, and the threads incrementing different (or the same) counters keep taking the lines from each other.
+   * Here the counters are split into shards, a full set of counters per shard. Each shard starts at a cache line
+   * boundary, and every thread increments the counters of its own shard (as long as there are no more threads than
+   * shards), so the lines stay in the cache of a single core.
+   *
+   * Increments are relaxed atomic operations: they're cheap, and they're never lost, but they don't order any other
+   * memory accesses. A \ref snapshot() sums the shards up. While increments are in progress, it may miss the latest
+   * of them.
+   *
+   * \include counter_array.cpp
+   */
+  template <typename E>
+  class counter_array : validator<E>
+  {
+  public:
+    using counter_type = std::uint64_t;
+
+    /**
+     * \brief Creates the counters, all zero, split into \c shard_count shards.
+     *
+     * The number of shards is rounded up to a power of two. By default, it's the number of hardware threads.
+     */
+    explicit counter_array(std::size_t shard_count = std::thread::hardware_concurrency()) :
+      _shard_mask(detail::round_up_to_power_of_two(shard_count) - 1),
+      _shards(std::make_unique<shard[]>(_shard_mask + 1))
+    {
+    }
+
+    counter_array(const counter_array&) = delete;
+    counter_array& operator=(const counter_array&) = delete;
+
+    /**
+     * \brief Adds \c n to the counter of \c e.
+     */
+    void increment(E e, counter_type n = 1) noexcept
+    {
+      _shards[detail::thread_shard_index() & _shard_mask].counters[index(e)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Returns the sum of the counter of \c e over all the shards.
+     */
+    counter_type value(E e) const noexcept
+    {
+      auto result = counter_type{0};
+
+      for (std::size_t i = 0; i <= _shard_mask; ++i)
+        result += _shards[i].counters[index(e)].load(std::memory_order_relaxed);
+
+      return result;
+    }
+
+    /**
+     * \brief Returns the sums of all the counters over all the shards.
+     */
+    array<E, counter_type> snapshot() const noexcept
+    {
+      auto result = array<E, counter_type>::make();
+
+      for (std::size_t i = 0; i <= _shard_mask; ++i)
+      {
+        for (std::size_t j = 0; j < result.size(); ++j)
+          result.data()[j] += _shards[i].counters[j].load(std::memory_order_relaxed);
+      }
+
+      return result;
+    }
+
+    /**
+     * \brief Sets all the counters to zero. Increments made concurrently may or may not survive.
+     */
+    void reset() noexcept
+    {
+      for (std::size_t i = 0; i <= _shard_mask; ++i)
+      {
+        for (auto& counter : _shards[i].counters)
+          counter.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * \brief Returns the number of shards.
+     */
+    std::size_t shard_count() const noexcept { return _shard_mask + 1; }
+
+  private:
+    struct alignas(detail::cache_line_size) shard
+    {
+      std::atomic<counter_type> counters[enum_utils::size<E>()] = {};
+    };
+
+    std::size_t _shard_mask;
+    std::unique_ptr<shard[]> _shards;
+  };
+
+  /** @}*/
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "basic.h"
+#include "sequence.h"
+#include "traits.h"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // The functor is either invoked with `std::integral_constant`s, or with the items as template parameters of its
+    // call operator (a C++20 template lambda, for instance).
+    template <typename F, typename... Constants>
+    constexpr decltype(auto) invoke_with_items(F& f, Constants... constants)
+    {
+      if constexpr (std::is_invocable<F&, Constants...>::value)
+        return f(constants...);
+      else
+        return f.template operator()<Constants::value...>();
+    }
+
+    template <typename F, typename... Es>
+    using dispatch_result_t =
+        decltype(invoke_with_items(std::declval<F&>(), std::integral_constant<Es, traits<Es>::first>{}...));
+
+    // The table is flattened in row-major order: the last enum changes the fastest.
+    template <typename... Es>
+    constexpr std::size_t dispatch_stride(std::size_t position) noexcept
+    {
+      constexpr std::size_t sizes[] = {size<Es>()...};
+
+      auto result = std::size_t{1};
+
+      for (auto i = position + 1; i < sizeof...(Es); ++i)
+        result *= sizes[i];
+
+      return result;
+    }
+
+    template <typename F, typename Positions, typename... Es>
+    struct dispatch_table;
+
+    template <typename F, std::size_t... positions, typename... Es>
+    struct dispatch_table<F, std::index_sequence<positions...>, Es...>
+    {
+      using result_type = dispatch_result_t<F, Es...>;
+      using entry_type  = result_type (*)(F&);
+
+      static constexpr std::size_t count = (size<Es>() * ...);
+
+      template <std::size_t k>
+      static result_type invoke(F& f)
+      {
+        return invoke_with_items(
+            f, std::integral_constant<Es, get<Es>(k / dispatch_stride<Es...>(positions) % size<Es>())>{}...);
+      }
+
+      template <std::size_t... ks>
+      static constexpr auto make_entries(std::index_sequence<ks...>) noexcept
+      {
+        return std::array<entry_type, sizeof...(ks)>{{&invoke<ks>...}};
+      }
+
+      static constexpr auto entries = make_entries(typename index_sequence_maker<count>::type{});
+
+      static std::size_t flatten(Es... es) noexcept { return ((index(es) * dispatch_stride<Es...>(positions)) + ...); }
+    };
+
+    template <typename F, typename... Es>
+    decltype(auto) dispatch_values(F& f, Es... es)
+    {
+      using table = dispatch_table<F, std::index_sequence_for<Es...>, Es...>;
+      return table::entries[table::flatten(es...)](f);
+    }
+
+    template <typename Arguments, std::size_t... positions>
+    decltype(auto) dispatch_arguments(Arguments arguments, std::index_sequence<positions...>)
+    {
+      return dispatch_values(std::get<sizeof...(positions)>(arguments), std::get<positions>(arguments)...);
+    }
+  }
+
+  /** \addtogroup traversalGroup
+   * @{
+   */
+
+  /**
+   * \brief Invokes \c f for runtime enum values as if they were known at compile time.
+   *
+   * The last argument is the functor, the rest are the values of (possibly different) enumerations. The functor is
+   * invoked with a \c std::integral_constant for each of the values, so a generic lambda can use them as constant
+   * expressions: as template arguments of \ref mapped_type_t, \ref map_to_value() and the like. Alternatively, the
+   * values are passed as template arguments of the call operator, if it's a template (\c f.template operator()<e>()).
+   *
+   * It replaces a \c switch statement with a case per item (or nested ones, for several values): every combination of
+   * the items gets its own instantiation of the call, and the address of the instantiation is stored in a constant
+   * table generated from \ref sequence_type. So the dispatch costs an indirect call, no matter how large the enums are.
+   * Mind that the table has an entry for every combination of the items, so its size is the product of the sizes of
+   * the enumerations.
+   *
+   * All the instantiations must return the same type. It's the result of the dispatch.
+   *
+   * The first enumeration may be specified explicitly (<tt>dispatch<E>(e, f)</tt>), the values are taken by value.
+   *
+   * \include dispatch.cpp
+   */
+  template <typename E, typename... Rest>
+  decltype(auto) dispatch(E e, Rest&&... rest)
+  {
+    static_assert(sizeof...(Rest) >= 1, "Pass at least one enum value and a functor.");
+
+    return detail::dispatch_arguments(std::forward_as_tuple(e, rest...), std::make_index_sequence<sizeof...(Rest)>{});
+  }
+
+  /** @}*/
+}
@@ -18,13 +18,30 @@
  * SOFTWARE.
  */
 
+#include "algorithm.h"
 #include "array.h"
 #include "basic.h"
+#include "bits.h"
+#include "bitset.h"
 #include "conversion.h"
+#include "counter_array.h"
+#include "dispatch.h"
 #include "exceptions.h"
+#include "histogram.h"
 #include "iterator.h"
+#include "lookup.h"
 #include "mapping.h"
+#include "matcher.h"
+#include "normalization.h"
+#include "optional_array.h"
+#include "preload.h"
 #include "range.h"
 #include "sequence.h"
+#include "soa_table.h"
+#include "sparse_traits.h"
+#include "static_conversion.h"
+#include "static_sort.h"
+#include "string_pool.h"
+#include "tagged_union.h"
 #include "traits.h"
 #include "variadic.h"
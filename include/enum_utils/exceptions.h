@@ -18,7 +18,7 @@
  * SOFTWARE.
  */
 
-#include <exception>
+#include <stdexcept>
 
 
 namespace enum_utils
@@ -26,9 +26,9 @@ namespace enum_utils
   /**
    * \brief This is the base exception of all the library exceptions.
    */
-  class exception : public std::exception
+  class exception : public std::runtime_error
   {
-    using std::exception::exception;
+    using std::runtime_error::runtime_error;
   };
 
   /** \addtogroup conversionGroup
@@ -48,6 +48,22 @@ namespace enum_utils
 
   /** @}*/
 
+  /** \addtogroup containersGroup
+   *  @{
+   */
+
+  /**
+   * \brief This exception is thrown on access to an alternative of a \ref tagged_union which isn't the active one.
+   *
+   * \sa tagged_union::get()
+   */
+  class bad_access : public exception
+  {
+    using exception::exception;
+  };
+
+  /** @}*/
+
   /** \addtogroup mappingGroup
    *  @{
    */
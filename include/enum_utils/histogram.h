@@ -0,0 +1,204 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "array.h"
+#include "basic.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // Small enumerations of a single byte are counted by comparison: every item is compared against a row of values,
+    // and the matches are summed up in byte-wide lanes. The loops are fixed and branchless, so compilers vectorize
+    // them. A lane takes up to 255 rows, and then it's flushed.
+    constexpr std::size_t histogram_lanes         = 32;
+    constexpr std::size_t histogram_rows          = 255;
+    constexpr std::size_t histogram_compare_limit = 8;
+
+    template <typename E>
+    constexpr bool histogram_by_comparison = sizeof(E) == 1 && size<E>() <= histogram_compare_limit;
+
+    template <typename E>
+    const E* count_by_comparison(const E* first, const E* last, std::size_t* counts) noexcept
+    {
+      constexpr auto n = size<E>();
+
+      while (static_cast<std::size_t>(last - first) >= histogram_lanes)
+      {
+        std::uint8_t lanes[n][histogram_lanes] = {};
+
+        for (std::size_t row = 0; row < histogram_rows && static_cast<std::size_t>(last - first) >= histogram_lanes;
+             ++row, first += histogram_lanes)
+        {
+          for (std::size_t k = 0; k < n; ++k)
+          {
+            for (std::size_t j = 0; j < histogram_lanes; ++j)
+              lanes[k][j] += first[j] == get<E>(k);
+          }
+        }
+
+        for (std::size_t k = 0; k < n; ++k)
+        {
+          for (std::size_t j = 0; j < histogram_lanes; ++j)
+            counts[k] += lanes[k][j];
+        }
+      }
+
+      return first;
+    }
+
+    // The rest are counted into four sub-histograms, one per value in a group of four. Repeated values then land in
+    // different counters, and the increments don't wait for each other to be stored and loaded back.
+    template <typename E>
+    const E* count_by_sub_histograms(const E* first, const E* last, std::size_t* counts)
+    {
+      constexpr auto n = size<E>();
+
+      // The counters are 32-bit, so they're flushed every 2^32 - 1 groups.
+      constexpr auto chunk = std::size_t{UINT32_MAX} * 4;
+
+      auto sub_histograms = std::vector<std::uint32_t>(4 * n);
+
+      while (static_cast<std::size_t>(last - first) >= 4)
+      {
+        const auto chunk_last = first + std::min(chunk, static_cast<std::size_t>(last - first) / 4 * 4);
+
+        std::fill(sub_histograms.begin(), sub_histograms.end(), 0);
+
+        auto h0 = sub_histograms.data();
+        auto h1 = h0 + n;
+        auto h2 = h1 + n;
+        auto h3 = h2 + n;
+
+        for (; first != chunk_last; first += 4)
+        {
+          ++h0[index(first[0])];
+          ++h1[index(first[1])];
+          ++h2[index(first[2])];
+          ++h3[index(first[3])];
+        }
+
+        for (std::size_t k = 0; k < n; ++k)
+          counts[k] += std::size_t{h0[k]} + h1[k] + h2[k] + h3[k];
+      }
+
+      return first;
+    }
+
+    template <typename E>
+    void count_values(const E* first, const E* last, std::size_t* counts)
+    {
+      if constexpr (histogram_by_comparison<E>)
+        first = count_by_comparison(first, last, counts);
+      else
+        first = count_by_sub_histograms(first, last, counts);
+
+      for (; first != last; ++first)
+        ++counts[index(*first)];
+    }
+  }
+
+  /** \addtogroup containersGroup
+   * @{
+   */
+
+  /**
+   * \brief Counts the occurrences of every item of \c E within <tt>[first, last)</tt>.
+   *
+   * It's a faster equivalent of incrementing an \ref array element for every value. Small single-byte enumerations
+   * (up to 8 items) are counted by comparison, which compilers vectorize. The rest are counted into several
+   * sub-histograms at once, so that runs of equal values don't serialize the increments.
+   *
+   * If \c threads is greater than one, the values are split into as many chunks, and each is counted by a thread of
+   * its own. Mind that starting threads costs some microseconds, so it only pays off for millions of values.
+   *
+   * \include histogram.cpp
+   */
+  template <typename E>
+  array<E, std::size_t> histogram(const E* first, const E* last, std::size_t threads = 1)
+  {
+    auto result = array<E, std::size_t>::make();
+
+    const auto count = static_cast<std::size_t>(last - first);
+    threads          = std::max<std::size_t>(std::min(threads, count / 4096), 1);
+
+    if (threads == 1)
+    {
+      detail::count_values(first, last, result.data());
+      return result;
+    }
+
+    auto partial = std::vector<array<E, std::size_t>>(threads - 1, result);
+    auto workers = std::vector<std::thread>{};
+
+    try
+    {
+      for (std::size_t i = 0; i < threads - 1; ++i)
+      {
+        const auto chunk_first = first + count * i / threads;
+        const auto chunk_last  = first + count * (i + 1) / threads;
+        const auto counts      = partial[i].data();
+
+        workers.emplace_back([=] { detail::count_values(chunk_first, chunk_last, counts); });
+      }
+
+      detail::count_values(first + count * (threads - 1) / threads, last, result.data());
+    }
+    catch (...)
+    {
+      for (auto& worker : workers)
+        worker.join();
+
+      throw;
+    }
+
+    for (std::size_t i = 0; i < threads - 1; ++i)
+    {
+      workers[i].join();
+
+      for (std::size_t k = 0; k < result.size(); ++k)
+        result.data()[k] += partial[i].data()[k];
+    }
+
+    return result;
+  }
+
+  /**
+   * \brief Counts the occurrences of every item within a contiguous container, such as \c std::vector or
+   * \c std::span.
+   */
+  template <typename Container>
+  auto histogram(const Container& values, std::size_t threads = 1)
+      -> array<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(values))>>, std::size_t>
+  {
+    return histogram(std::data(values), std::data(values) + std::size(values), threads);
+  }
+
+  /** @}*/
+}
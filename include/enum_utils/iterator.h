@@ -20,6 +20,7 @@
 
 #include "basic.h"
 
+#include <cstddef>
 #include <iterator>
 
 
@@ -32,55 +33,84 @@ namespace enum_utils
   /**
    * \brief An iterator to traverse enumerations.
    *
-   * It's implemented as a bidirectional iterator for now.
+   * It's a random access iterator (and a \c std::random_access_iterator in C++20), so the distance between two
+   * iterators is obtained in O(1), and standard algorithms, including the parallel ones, can split a \ref range into
+   * chunks. The iterator keeps the index of the item rather than the item itself, so the past-the-end iterator is fine
+   * even if the last item is the largest value of the underlying type.
+   *
+   * The items are returned by value, there's nothing to refer to.
    *
    * \sa range
    */
   template <typename E>
-  struct iterator :
-    validator<E>,
-    std::iterator<std::bidirectional_iterator_tag, E> // TODO: Promote to random_access_iterator.
+  struct iterator : validator<E>
   {
-    iterator() noexcept : _e() {}
-    explicit iterator(E e) noexcept : _e(e) {}
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using value_type        = E;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = E;
+
+    constexpr iterator() noexcept : _index() {}
+    constexpr explicit iterator(E e) noexcept : _index(static_cast<difference_type>(index(e))) {}
 
-    E operator*() const noexcept { return _e; }
+    constexpr E operator*() const noexcept { return get<E>(static_cast<std::size_t>(_index)); }
+    constexpr E operator[](difference_type n) const noexcept { return get<E>(static_cast<std::size_t>(_index + n)); }
 
-    iterator operator++() noexcept
+    constexpr iterator& operator++() noexcept
     {
-      _e = next(_e);
+      ++_index;
       return *this;
     }
 
-    iterator operator++(int) noexcept
+    constexpr iterator operator++(int) noexcept
     {
-      E tmp = *this;
-      _e    = next(_e);
+      auto tmp = *this;
+      ++_index;
       return tmp;
     }
 
-    iterator operator--() noexcept
+    constexpr iterator& operator--() noexcept
     {
-      _e = prev(_e);
+      --_index;
       return *this;
     }
 
-    iterator operator--(int) noexcept
+    constexpr iterator operator--(int) noexcept
     {
-      E tmp = *this;
-      _e    = prev(_e);
+      auto tmp = *this;
+      --_index;
       return tmp;
     }
 
-    bool operator==(iterator other) { return _e == other._e; }
-    bool operator!=(iterator other) { return _e != other._e; }
-    bool operator<(iterator other) { return index(_e) < index(other._e); }
-    bool operator>(iterator other) { return index(_e) > index(other._e); }
-    bool operator<=(iterator other) { return index(_e) <= index(other._e); }
-    bool operator>=(iterator other) { return index(_e) >= index(other._e); }
+    constexpr iterator& operator+=(difference_type n) noexcept
+    {
+      _index += n;
+      return *this;
+    }
+
+    constexpr iterator& operator-=(difference_type n) noexcept
+    {
+      _index -= n;
+      return *this;
+    }
+
+    friend constexpr iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+    friend constexpr iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+    friend constexpr iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+
+    friend constexpr difference_type operator-(iterator lhs, iterator rhs) noexcept { return lhs._index - rhs._index; }
+
+    friend constexpr bool operator==(iterator lhs, iterator rhs) noexcept { return lhs._index == rhs._index; }
+    friend constexpr bool operator!=(iterator lhs, iterator rhs) noexcept { return lhs._index != rhs._index; }
+    friend constexpr bool operator<(iterator lhs, iterator rhs) noexcept { return lhs._index < rhs._index; }
+    friend constexpr bool operator>(iterator lhs, iterator rhs) noexcept { return lhs._index > rhs._index; }
+    friend constexpr bool operator<=(iterator lhs, iterator rhs) noexcept { return lhs._index <= rhs._index; }
+    friend constexpr bool operator>=(iterator lhs, iterator rhs) noexcept { return lhs._index >= rhs._index; }
 
     /** \privatesection */
-    E _e;
+    difference_type _index;
   };
 
   /** @}*/
@@ -0,0 +1,474 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "array.h"
+#include "basic.h"
+#include "normalization.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // The reverse lookup is built upon a minimal perfect hash (the "hash and displace" scheme). Every key is hashed
+    // once, then the hash picks a bucket, and the per-bucket displacement moves the hash into its own slot. Slots are
+    // stored contiguously, so a successful lookup costs a hash, a multiplication and a single key compare. Keys whose
+    // hashes fully collide can't be told apart by any displacement, so they're kept in a (normally empty) overflow list
+    // which is searched linearly.
+
+    constexpr std::uint64_t mix_hash(std::uint64_t h) noexcept
+    {
+      h ^= h >> 30;
+      h *= 0xbf58476d1ce4e5b9ull;
+      h ^= h >> 27;
+      h *= 0x94d049bb133111ebull;
+      h ^= h >> 31;
+      return h;
+    }
+
+    // Maps the upper 32 bits of `h` onto [0, n) without a division.
+    constexpr std::size_t reduce_hash(std::uint64_t h, std::size_t n) noexcept
+    {
+      return static_cast<std::size_t>(((h >> 32) * static_cast<std::uint64_t>(n)) >> 32);
+    }
+
+    // Strings are hashed by the library itself: `std::hash` is noticeably slower on short keys, which is exactly
+    // what enum names usually are. Every word is folded by `Policy` before it's mixed in, so the keys are normalized
+    // on the fly.
+    template <typename Policy = exact_match>
+    std::uint64_t hash_bytes(const void* data, std::size_t size) noexcept
+    {
+      const auto* bytes = static_cast<const unsigned char*>(data);
+      auto        h     = 0x9e3779b97f4a7c15ull ^ size;
+
+      for (; size >= 8; size -= 8, bytes += 8)
+      {
+        auto word = std::uint64_t{};
+        std::memcpy(&word, bytes, 8);
+        h = (h ^ Policy::fold_word(word)) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+      }
+
+      // The tail is read with two overlapping loads (or byte by byte if it's too short), so there's no call to a
+      // variable length `memcpy`.
+      if (size >= 4)
+      {
+        auto lo = std::uint32_t{};
+        auto hi = std::uint32_t{};
+        std::memcpy(&lo, bytes, 4);
+        std::memcpy(&hi, bytes + size - 4, 4);
+        h = (h ^ Policy::fold_word(static_cast<std::uint64_t>(hi) << 32 | lo)) * 0xff51afd7ed558ccdull;
+      }
+      else if (size > 0)
+      {
+        const auto word = static_cast<std::uint64_t>(bytes[0]) << 16 | static_cast<std::uint64_t>(bytes[size / 2]) << 8 |
+                          bytes[size - 1];
+        h = (h ^ Policy::fold_word(word)) * 0xff51afd7ed558ccdull;
+      }
+
+      return mix_hash(h);
+    }
+
+    inline void prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+      _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+      static_cast<void>(address);
+#endif
+    }
+
+    // Values of `T` are looked up with the normalization `Policy`. Any value is fine for `exact_match`, the rest of the
+    // policies apply to strings only.
+    template <typename T, typename Policy = exact_match>
+    struct lookup_traits
+    {
+      static_assert(std::is_same<Policy, exact_match>::value, "Only strings can be looked up with a normalization policy.");
+
+      static std::uint64_t hash(const T& value) { return mix_hash(std::hash<T>{}(value)); }
+
+      template <typename K>
+      static bool equal(const T& folded_value, const K& key)
+      {
+        return folded_value == key;
+      }
+
+      static void fold(T&) noexcept {}
+    };
+
+    template <typename C, typename Traits, typename Allocator, typename Policy>
+    struct lookup_traits<std::basic_string<C, Traits, Allocator>, Policy>
+    {
+      using value_type = std::basic_string<C, Traits, Allocator>;
+      using view_type  = std::basic_string_view<C, Traits>;
+
+      static std::uint64_t hash(view_type value) noexcept
+      {
+        return hash_bytes<Policy>(value.data(), value.size() * sizeof(C));
+      }
+
+      // The stored values are folded beforehand, so only the key is folded here.
+      static bool equal(const value_type& folded_value, view_type key) noexcept
+      {
+        if constexpr (std::is_same<Policy, exact_match>::value)
+          return view_type{folded_value} == key;
+
+        if (folded_value.size() != key.size())
+          return false;
+
+        for (std::size_t i = 0; i < key.size(); ++i)
+        {
+          if (!Traits::eq(folded_value[i], Policy::fold(key[i])))
+            return false;
+        }
+
+        return true;
+      }
+
+      static void fold(value_type& value) noexcept
+      {
+        for (auto& c : value)
+          c = Policy::fold(c);
+      }
+    };
+
+    // Keys of some types are looked up among values of other types as is. That's how string views are matched against
+    // strings without allocating a temporary string.
+    template <typename K>
+    struct lookup_value
+    {
+      using type = K;
+    };
+
+    template <typename C, typename Traits>
+    struct lookup_value<std::basic_string_view<C, Traits>>
+    {
+      using type = std::basic_string<C, Traits>;
+    };
+
+    template <typename K>
+    using lookup_value_t = typename lookup_value<K>::type;
+
+    // The allocator is used for the table itself. Temporary data needed to build it is allocated as usual.
+    template <typename E, typename T, typename Policy = exact_match, typename Allocator = std::allocator<T>>
+    class reverse_lookup_table
+    {
+      using traits_type = lookup_traits<T, Policy>;
+
+      template <typename U>
+      using allocator_for = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+      template <typename U>
+      using vector_type = std::vector<U, allocator_for<U>>;
+
+    public:
+      explicit reverse_lookup_table(const Allocator& allocator = Allocator{}) :
+        _displacements(allocator_for<std::uint64_t>(allocator)),
+        _slots(allocator_for<slot>(allocator)),
+        _overflow(allocator_for<slot>(allocator))
+      {
+      }
+
+      explicit reverse_lookup_table(const array<E, T>& values, const Allocator& allocator = Allocator{}) :
+        reverse_lookup_table(allocator)
+      {
+        if constexpr (std::is_same<Policy, exact_match>::value)
+        {
+          build(values);
+        }
+        else
+        {
+          // The values are folded once here, so that the lookup folds the keys only.
+          auto folded = values;
+
+          for (auto& value : folded)
+            traits_type::fold(value);
+
+          build(folded);
+        }
+      }
+
+      /**
+       * Tells whether multiple items match the same value. The table is still usable, but the lookup result for such
+       * a value is unspecified.
+       */
+      bool is_ambiguous() const noexcept { return _is_ambiguous; }
+
+      /**
+       * Returns a pointer to the item matching \c key, or \c nullptr if there's none.
+       *
+       * \c K is either \c T or any type \c T is looked up by (see \c lookup_value).
+       */
+      template <typename K>
+      const E* find(const K& key) const
+      {
+        return match(candidate(traits_type::hash(key)), key);
+      }
+
+      /**
+       * Looks up \c count keys at once. The i-th item found is written to \c items[i] (or \c default_value if there's
+       * none), and the outcome to \c found[i]. Returns the number of found items.
+       *
+       * Keys are processed in blocks: the slots of a whole block are located and prefetched before any of them is
+       * compared, so fetching slots from memory overlaps with hashing of the following keys.
+       */
+      template <typename K>
+      std::size_t find(const K* keys, std::size_t count, E* items, bool* found, E default_value) const
+      {
+        static constexpr std::size_t block_size = 16;
+
+        const slot* candidates[block_size];
+        auto        result = std::size_t{0};
+
+        for (std::size_t first = 0; first < count; first += block_size)
+        {
+          const auto size = std::min(block_size, count - first);
+
+          for (std::size_t i = 0; i < size; ++i)
+          {
+            candidates[i] = candidate(traits_type::hash(keys[first + i]));
+            prefetch(candidates[i]);
+          }
+
+          for (std::size_t i = 0; i < size; ++i)
+          {
+            const auto item = match(candidates[i], keys[first + i]);
+
+            items[first + i] = item ? *item : default_value;
+            found[first + i] = item != nullptr;
+            result += item != nullptr;
+          }
+        }
+
+        return result;
+      }
+
+    private:
+      struct slot
+      {
+        T value;
+        E item;
+      };
+
+      void build(const array<E, T>& values)
+      {
+        const auto hashes = hash_values(values);
+        auto       keys   = std::vector<std::size_t>(values.size());
+
+        for (std::size_t i = 0; i < keys.size(); ++i)
+          keys[i] = i;
+
+        std::sort(keys.begin(), keys.end(), [&](std::size_t lhs, std::size_t rhs) { return hashes[lhs] < hashes[rhs]; });
+
+        auto placeable = std::vector<std::size_t>{};
+
+        for (std::size_t first = 0, last = 0; first < keys.size(); first = last)
+        {
+          last = first + 1;
+
+          while (last < keys.size() && hashes[keys[last]] == hashes[keys[first]])
+            ++last;
+
+          if (last - first == 1)
+          {
+            placeable.push_back(keys[first]);
+            continue;
+          }
+
+          for (auto i = first; i < last; ++i)
+          {
+            for (auto j = i + 1; j < last; ++j)
+              _is_ambiguous = _is_ambiguous || values[get<E>(keys[i])] == values[get<E>(keys[j])];
+
+            _overflow.push_back(slot{values[get<E>(keys[i])], get<E>(keys[i])});
+          }
+        }
+
+        place(values, hashes, placeable);
+      }
+
+      const slot* candidate(std::uint64_t h) const noexcept
+      {
+        if (_slots.empty())
+          return nullptr;
+
+        return &_slots[slot_index(h, _displacements[bucket_index(h)], _slots.size())];
+      }
+
+      template <typename K>
+      const E* match(const slot* candidate, const K& key) const
+      {
+        if (candidate && traits_type::equal(candidate->value, key))
+          return &candidate->item;
+
+        for (const auto& s : _overflow)
+        {
+          if (traits_type::equal(s.value, key))
+            return &s.item;
+        }
+
+        return nullptr;
+      }
+
+      static std::uint64_t hash(const T& value) { return traits_type::hash(value); }
+
+      static std::vector<std::uint64_t> hash_values(const array<E, T>& values)
+      {
+        auto result = std::vector<std::uint64_t>{};
+        result.reserve(values.size());
+
+        for (const auto& value : values)
+          result.push_back(hash(value));
+
+        return result;
+      }
+
+      std::size_t bucket_index(std::uint64_t h) const noexcept
+      {
+        return reduce_hash(h << 32, _displacements.size());
+      }
+
+      static std::uint64_t displacement(std::uint32_t seed) noexcept { return seed * 0x9e3779b97f4a7c15ull; }
+
+      static std::size_t slot_index(std::uint64_t h, std::uint64_t displacement, std::size_t slot_count) noexcept
+      {
+        return reduce_hash((h ^ displacement) * 0xbf58476d1ce4e5b9ull, slot_count);
+      }
+
+      void place(const array<E, T>& values, const std::vector<std::uint64_t>& hashes, std::vector<std::size_t> keys)
+      {
+        static constexpr auto no_key = std::numeric_limits<std::size_t>::max();
+
+        if (keys.empty())
+          return;
+
+        // Slots aren't constructed until every key finds its place (`T` isn't required to be default constructible),
+        // so only their owners are tracked meanwhile.
+        const auto slot_count = keys.size();
+        auto       owners     = std::vector<std::size_t>(slot_count, no_key);
+
+        _displacements.assign((slot_count + 3) / 4, 0);
+
+        auto buckets = std::vector<std::vector<std::size_t>>(_displacements.size());
+
+        for (const auto key : keys)
+          buckets[bucket_index(hashes[key])].push_back(key);
+
+        auto order = std::vector<std::size_t>(buckets.size());
+
+        for (std::size_t i = 0; i < order.size(); ++i)
+          order[i] = i;
+
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+          return buckets[lhs].size() > buckets[rhs].size();
+        });
+
+        const auto max_seed = static_cast<std::uint32_t>(std::min<std::uint64_t>(
+            std::numeric_limits<std::uint32_t>::max(), 64 * static_cast<std::uint64_t>(slot_count) + 4096));
+
+        auto taken = std::vector<std::size_t>{};
+
+        for (const auto b : order)
+        {
+          const auto& bucket = buckets[b];
+
+          if (bucket.empty())
+            break;
+
+          auto is_placed = false;
+
+          for (std::uint32_t seed = 0; seed < max_seed && !is_placed; ++seed)
+          {
+            taken.clear();
+            is_placed = true;
+
+            for (const auto key : bucket)
+            {
+              const auto s = slot_index(hashes[key], displacement(seed), slot_count);
+
+              if (owners[s] != no_key || std::find(taken.begin(), taken.end(), s) != taken.end())
+              {
+                is_placed = false;
+                break;
+              }
+
+              taken.push_back(s);
+            }
+
+            if (is_placed)
+            {
+              _displacements[b] = displacement(seed);
+
+              for (std::size_t i = 0; i < bucket.size(); ++i)
+                owners[taken[i]] = bucket[i];
+            }
+          }
+
+          // Practically unreachable, but the lookup stays correct anyway.
+          if (!is_placed)
+          {
+            for (const auto key : bucket)
+              _overflow.push_back(slot{values[get<E>(key)], get<E>(key)});
+          }
+        }
+
+        const auto filler = std::find_if(owners.begin(), owners.end(), [](std::size_t o) { return o != no_key; });
+
+        if (filler == owners.end())
+        {
+          _displacements.clear();
+          return;
+        }
+
+        // Vacant slots (if any) duplicate an occupied one. They're never reached by a key equal to the duplicated
+        // value, but even if they were, the result would still be correct.
+        _slots.reserve(slot_count);
+
+        for (const auto owner : owners)
+        {
+          const auto key = owner != no_key ? owner : *filler;
+          _slots.push_back(slot{values[get<E>(key)], get<E>(key)});
+        }
+      }
+
+      vector_type<std::uint64_t> _displacements;
+      vector_type<slot>          _slots;
+      vector_type<slot>          _overflow;
+      bool                       _is_ambiguous = false;
+    };
+  }
+}
@@ -20,9 +20,13 @@
 
 #include "basic.h"
 #include "exceptions.h"
+#include "sequence.h"
+#include "static_sort.h"
 #include "traits.h"
 
-#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -64,38 +68,195 @@ namespace enum_utils
       using type = T;
     };
 
-    template <typename E, typename T, typename Tag, int ind>
-    struct mapped_enum_helper :
-      std::conditional_t<
-          std::is_same<T, mapped_type_t<E, get<E>(ind), Tag>>::value,
-          std::integral_constant<E, get<E>(ind)>,
-          mapped_enum_helper<E, T, Tag, ind - 1>>
+    template <typename E, E e, typename T, typename Tag, typename = void>
+    struct is_mapped_to : std::false_type
+    {
+    };
+
+    template <typename E, E e, typename T, typename Tag>
+    struct is_mapped_to<E, e, T, Tag, std::void_t<typename mapped_type<E, e, Tag>::type>> :
+      std::is_same<T, typename mapped_type<E, e, Tag>::type>
+    {
+    };
+
+    constexpr auto no_mapped_index = static_cast<std::size_t>(-1);
+
+    // All the items are checked at once by a single pack expansion over `sequence_type` (which is generated with
+    // logarithmic depth), so neither the instantiation depth nor the number of instantiations grows with recursion.
+    // The search goes backwards: the last item mapped to `T` wins.
+    template <typename E, typename T, typename Tag, E... es>
+    constexpr std::size_t find_mapped_index(sequence<E, es...>) noexcept
+    {
+      constexpr bool matches[] = {is_mapped_to<E, es, T, Tag>::value...};
+
+      for (auto i = sizeof...(es); i-- > 0;)
+      {
+        if (matches[i])
+          return i;
+      }
+
+      return no_mapped_index;
+    }
+
+    template <typename E, typename T, typename Tag, std::size_t ind = find_mapped_index<E, T, Tag>(sequence_type<E>{})>
+    struct mapped_enum_helper : std::integral_constant<E, get<E>(ind)>
     {
     };
 
     template <typename E, typename T, typename Tag>
-    struct mapped_enum_helper<E, T, Tag, -1>
+    struct mapped_enum_helper<E, T, Tag, no_mapped_index>
     {
       static_assert(!std::is_same<E, E>::value, "no enum value matching this type");
     };
 
-    template <typename T, typename E, int l, int r, int m = (l + r) / 2>
-    constexpr const T map_to_value(E e) noexcept
+    template <typename E, typename T>
+    struct mapped_values
+    {
+      template <E... es>
+      static constexpr std::array<T, sizeof...(es)> make(sequence<E, es...>)
+      {
+        return std::array<T, sizeof...(es)>{{mapped_value<E, es, T>::value...}};
+      }
+
+      static constexpr auto values = make(sequence_type<E>{});
+    };
+
+    // The reverse mapping is backed by an inverse index generated at compile time. Integral values spanning a compact
+    // range are looked up in a direct table, other ordered values are binary searched, and the rest are compared one by
+    // one. Whatever the index is, the last item mapped to a value wins.
+
+    template <typename T, typename = void>
+    struct is_ordered : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_ordered<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>> : std::true_type
+    {
+    };
+
+    template <typename E, typename T>
+    struct dense_inverse_mapping
     {
-      static_assert(l <= r, "something went terribly wrong");
+      static constexpr const auto& values = mapped_values<E, T>::values;
+
+      // The distance is computed in the unsigned domain, so it can't overflow even for the extreme values of signed
+      // types.
+      static constexpr std::uint64_t distance(T from, T to) noexcept
+      {
+        return static_cast<std::uint64_t>(to) - static_cast<std::uint64_t>(from);
+      }
+
+      static constexpr std::pair<T, T> make_bounds()
+      {
+        auto result = std::make_pair(values[0], values[0]);
+
+        for (const auto& value : values)
+        {
+          result.first  = value < result.first ? value : result.first;
+          result.second = value > result.second ? value : result.second;
+        }
+
+        return result;
+      }
+
+      static constexpr auto bounds = make_bounds();
+
+      // A direct table is worth it as long as it isn't much larger than the enum itself.
+      static constexpr bool is_compact = distance(bounds.first, bounds.second) < 4 * size<E>() + 64;
+
+      // Zero means no item, otherwise it's the index of the item plus one.
+      using slot_type = smallest_unsigned_t<size<E>()>;
+      using slots     = std::array<slot_type, is_compact ? distance(bounds.first, bounds.second) + 1 : 1>;
+
+      static constexpr slots make_slots()
+      {
+        auto result = slots{};
 
-      return m == index(e) ? mapped_value<E, get<E>(m), T>::value
-                           : m > index(e) ? map_to_value<T, E, l, std::max(m - 1, l)>(e)  // First half.
-                                          : map_to_value<T, E, std::min(m + 1, r), r>(e); // Second half.
+        for (std::size_t i = 0; i < values.size(); ++i)
+          result[distance(bounds.first, values[i])] = static_cast<slot_type>(i + 1);
+
+        return result;
+      }
+
+      static constexpr slots table = make_slots();
+
+      static constexpr std::pair<E, bool> find(T v) noexcept
+      {
+        if (v < bounds.first || v > bounds.second)
+          return std::make_pair(traits<E>::first, false);
+
+        const auto slot = table[distance(bounds.first, v)];
+
+        return slot != 0 ? std::make_pair(get<E>(slot - 1), true) : std::make_pair(traits<E>::first, false);
+      }
+    };
+
+    template <typename E, typename T>
+    struct sorted_inverse_mapping
+    {
+      using entry      = static_entry<E, T>;
+      using comparator = static_comparator<T>;
+      using entries    = std::array<entry, size<E>()>;
+
+      static constexpr entries make_entries()
+      {
+        auto result = entries{};
+
+        for (std::size_t i = 0; i < result.size(); ++i)
+          result[i] = entry{mapped_values<E, T>::values[i], get<E>(i)};
+
+        sort_entries<comparator>(result);
+        return result;
+      }
+
+      static constexpr entries sorted = make_entries();
+
+      // The sort is stable, so the last of equal values belongs to the last item mapped to it.
+      static constexpr std::pair<E, bool> find(const T& v) noexcept
+      {
+        const auto last = upper_bound<comparator>(sorted, v);
+
+        return last > 0 && comparator::equal(sorted[last - 1].value, v) ? std::make_pair(sorted[last - 1].item, true)
+                                                                         : std::make_pair(traits<E>::first, false);
+      }
+    };
+
+    template <typename E, typename T>
+    struct linear_inverse_mapping
+    {
+      static constexpr std::pair<E, bool> find(const T& v) noexcept
+      {
+        const auto& values = mapped_values<E, T>::values;
+
+        for (auto i = values.size(); i-- > 0;)
+        {
+          if (values[i] == v)
+            return std::make_pair(get<E>(i), true);
+        }
+
+        return std::make_pair(traits<E>::first, false);
+      }
+    };
+
+    template <typename E, typename T>
+    constexpr bool is_densely_mapped() noexcept
+    {
+      if constexpr (std::is_integral<T>::value)
+        return dense_inverse_mapping<E, T>::is_compact;
+      else
+        return false;
     }
 
-    template <typename E, typename T, int ind>
+    template <typename E, typename T>
     constexpr std::pair<E, bool> try_map_to_enum(const T& v) noexcept
     {
-      // TODO: Try to avoid linear search somehow [anikin].
-      return v == mapped_value<E, get<E>(ind), std::decay_t<T>>::value
-                 ? std::make_pair(get<E>(ind), true)
-                 : ind == 0 ? std::make_pair(get<E>(ind), false) : try_map_to_enum<E, T, std::max(ind - 1, 0)>(v);
+      if constexpr (is_densely_mapped<E, T>())
+        return dense_inverse_mapping<E, T>::find(v);
+      else if constexpr (is_ordered<T>::value && std::is_default_constructible<T>::value)
+        return sorted_inverse_mapping<E, T>::find(v);
+      else
+        return linear_inverse_mapping<E, T>::find(v);
     }
   }
 
@@ -103,23 +264,27 @@ namespace enum_utils
    * \brief An alias for `type -> enum` mapping.
    */
   template <typename E, typename T, typename Tag = detail::default_tag>
-  using mapped_enum = detail::mapped_enum_helper<E, T, Tag, size<E>() - 1>;
+  using mapped_enum = detail::mapped_enum_helper<E, T, Tag>;
 
   /**
    * \brief Returns a value of a structural type \c T statically mapped to a passed item of \c E.
    *
-   * The function is O(logN) at compile-time, but always O(1) at runtime.
+   * All the values mapped to the items of \c E are gathered into a single constant array at compile time, so the
+   * function is a mere indexed load at runtime.
    */
   template <typename T, typename E>
   constexpr const T map_to_value(E e) noexcept
   {
-    return detail::map_to_value<T, E, 0, size<E>() - 1>(e);
+    return detail::mapped_values<E, T>::values[index(e)];
   }
 
   /**
    * \brief Tries to statically map \c v, a value of a structural type \c T, back to an item of \c E.
    *
-   * The function is O(N) at compile-time, but always O(1) at runtime.
+   * The inverse index is generated at compile time, and the index is chosen automatically. If \c T is integral, and
+   * the mapped values are compact enough, it's a direct table, so the mapping is O(1) even if \c v is only known at
+   * runtime. Otherwise, if \c T is ordered, it's a sorted array searched in O(logN). If several items are mapped to
+   * the same value, the last one of them is found.
    *
    * \returns \c std::pair<E, true> on successful mapping (a corresponding item is found) or \c std::pair<_first, false>
    * otherwise.
@@ -128,7 +293,7 @@ namespace enum_utils
   template <typename E, typename T>
   constexpr std::pair<E, bool> try_map_to_enum(const T& v) noexcept
   {
-    return detail::try_map_to_enum<E, T, size<E>() - 1>(v);
+    return detail::try_map_to_enum<E, std::decay_t<T>>(v);
   }
 
   /**
@@ -151,6 +316,20 @@ namespace enum_utils
     return result.first;
   }
 
+  /**
+   * \brief Maps \c v, a value of a structural type \c T, either back to an item of \c E or to a passed default value.
+   *
+   * Essentially same as the other overload, but never throws \ref bad_mapping. Instead it returns passed
+   * \c default_value if no item matches \c v.
+   * \sa try_map_to_enum()
+   */
+  template <typename E, typename T>
+  constexpr E map_to_enum(const T& v, E default_value) noexcept
+  {
+    const auto result = try_map_to_enum<E>(v);
+    return result.second ? result.first : default_value;
+  }
+
   /** @}*/
 }
 
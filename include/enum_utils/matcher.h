@@ -0,0 +1,366 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "array.h"
+#include "basic.h"
+#include "conversion.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // A deterministic automaton recognizing the string values of `E`. It's a trie whose transitions are stored in a
+    // dense table: a row per state and a column per byte class. Bytes that behave the same in every state share
+    // a class, so the table stays small no matter how sparse the alphabet of the values is.
+    //
+    // A state is the offset of its row in the table, with two flags on top: whether the state accepts a value and
+    // whether it's final. So a step costs a single load of the transition, which also tells the matcher what to do
+    // next. The state at offset 0 is the dead one (no value starts with the input seen), the next one is the initial.
+    template <typename E>
+    class keyword_automaton
+    {
+    public:
+      using state_type = std::uint32_t;
+
+      static constexpr state_type dead_state = 0;
+
+      explicit keyword_automaton(const array<E, std::string>& values)
+      {
+        auto trie = std::vector<std::map<unsigned char, state_type>>(2);
+        auto item = std::vector<std::size_t>(2, no_item);
+
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+          const auto& value = values[get<E>(i)];
+
+          // An empty value would match anywhere without consuming anything.
+          if (value.empty())
+            continue;
+
+          auto state = state_type{1};
+
+          for (const auto c : value)
+          {
+            const auto inserted = trie[state].emplace(static_cast<unsigned char>(c), static_cast<state_type>(trie.size()));
+
+            if (inserted.second)
+            {
+              trie.emplace_back();
+              item.push_back(no_item);
+            }
+
+            state = inserted.first->second;
+          }
+
+          if (item[state] == no_item)
+          {
+            item[state] = i;
+          }
+          else
+          {
+            item[state]   = ambiguous_item;
+            _is_ambiguous = true;
+          }
+        }
+
+        classify(trie);
+
+        if (trie.size() * _class_count > offset_mask)
+          throw std::length_error{"The values are too long to be recognized by an automaton"};
+
+        const auto encode = [&](std::size_t state) {
+          return static_cast<state_type>(state * _class_count) | (item[state] < values.size() ? accepting_flag : 0) |
+                 (trie[state].empty() ? final_flag : 0);
+        };
+
+        _transitions.assign(trie.size() * _class_count, dead_state);
+        _items.reserve(trie.size());
+
+        for (std::size_t state = 0; state < trie.size(); ++state)
+        {
+          for (const auto& transition : trie[state])
+            _transitions[state * _class_count + _classes[transition.first]] = encode(transition.second);
+
+          _items.push_back(item[state]);
+        }
+
+        _initial_state = encode(1);
+      }
+
+      bool is_ambiguous() const noexcept { return _is_ambiguous; }
+
+      state_type initial_state() const noexcept { return _initial_state; }
+
+      state_type next(state_type state, char c) const noexcept
+      {
+        return _transitions[(state & offset_mask) + _classes[static_cast<unsigned char>(c)]];
+      }
+
+      static bool is_accepting(state_type state) noexcept { return (state & accepting_flag) != 0; }
+
+      // Tells whether no value continues past `state`, so there's no need to look at the next byte.
+      static bool is_final(state_type state) noexcept { return (state & final_flag) != 0; }
+
+      // Returns the index of the item accepted in `state`. Valid for accepting states only.
+      std::size_t item(state_type state) const noexcept { return _items[(state & offset_mask) / _class_count]; }
+
+    private:
+      static constexpr state_type accepting_flag = state_type{1} << 31;
+      static constexpr state_type final_flag     = state_type{1} << 30;
+      static constexpr state_type offset_mask    = final_flag - 1;
+
+      static constexpr auto no_item        = static_cast<std::size_t>(-1);
+      static constexpr auto ambiguous_item = static_cast<std::size_t>(-2);
+
+      // Splits the bytes into classes by refining the partition state by state: two bytes stay in the same class only
+      // if they lead to the same state from every state.
+      void classify(const std::vector<std::map<unsigned char, state_type>>& trie)
+      {
+        std::fill(std::begin(_classes), std::end(_classes), 0);
+        _class_count = 1;
+
+        for (const auto& transitions : trie)
+        {
+          if (transitions.empty())
+            continue;
+
+          auto refined = std::map<std::pair<std::size_t, state_type>, std::size_t>{};
+
+          for (std::size_t c = 0; c <= UCHAR_MAX; ++c)
+          {
+            const auto transition = transitions.find(static_cast<unsigned char>(c));
+            const auto target     = transition != transitions.end() ? transition->second : dead_state;
+            const auto key        = std::make_pair(static_cast<std::size_t>(_classes[c]), target);
+
+            _classes[c] = static_cast<std::uint8_t>(refined.emplace(key, refined.size()).first->second);
+          }
+
+          _class_count = refined.size();
+        }
+      }
+
+      std::uint8_t             _classes[UCHAR_MAX + 1];
+      std::size_t              _class_count = 1;
+      std::vector<state_type>  _transitions;
+      std::vector<std::size_t> _items;
+      state_type               _initial_state = dead_state;
+      bool                     _is_ambiguous  = false;
+    };
+
+    template <typename E>
+    struct keyword_automaton_storage
+    {
+      static inline std::atomic<const keyword_automaton<E>*> automaton{nullptr};
+    };
+
+    template <typename E>
+    const keyword_automaton<E>& make_default_keyword_automaton()
+    {
+      static const auto automaton = keyword_automaton<E>{default_conversion_table<E, std::string>().values()};
+
+      keyword_automaton_storage<E>::automaton.store(&automaton, std::memory_order_release);
+      return automaton;
+    }
+
+    template <typename E>
+    const keyword_automaton<E>& default_keyword_automaton()
+    {
+      const auto automaton = keyword_automaton_storage<E>::automaton.load(std::memory_order_acquire);
+      return automaton ? *automaton : make_default_keyword_automaton<E>();
+    }
+  }
+
+  /** \addtogroup conversionGroup
+   * @{
+   */
+
+  /**
+   * \brief The status of \ref matcher::feed() and \ref matcher::finish().
+   */
+  enum class match_status
+  {
+    matched,    ///< A value has been recognized.
+    no_match,   ///< The input doesn't start with any value.
+    incomplete, ///< The whole chunk belongs to a value which isn't recognized yet, feed the next one.
+  };
+
+  /**
+   * \brief The outcome of \ref matcher::feed() and \ref matcher::finish().
+   */
+  template <typename E>
+  struct match_result
+  {
+    match_status status;   ///< What happened.
+    E            item;     ///< The recognized item if \c status is \c match_status::matched, or \c _first otherwise.
+    std::size_t  consumed; ///< The number of bytes of the chunk consumed.
+    std::size_t  length;   ///< The length of the recognized value or, if there's none, of the input examined.
+  };
+
+  /**
+   * \brief Recognizes the string values of \c E in a stream of bytes, one chunk at a time.
+   *
+   * The values are those of the conversion to \c std::string (see \ref ENUM_UTILS_DEFINE_CONVERSION()). They're
+   * compiled into a deterministic automaton once per \c E, the matchers merely keep track of where they are in it.
+   * Thus a matcher is cheap to construct, and there may be as many of them as there are streams to read.
+   *
+   * Every byte of the input is examined exactly once, and the input is never copied. The longest value wins: if both
+   * \c "get" and \c "getter" are values, \c "getters" is recognized as \c "getter". Matching resumes across chunk
+   * boundaries. When a chunk ends in the middle of a value, \ref feed() reports \c match_status::incomplete and
+   * carries on with the next chunk. At the end of the stream, \ref finish() tells what the pending input was.
+   *
+   * A value is recognized as soon as the byte after it doesn't continue any other value, or right away if no value
+   * is longer. After that (as well as after \c match_status::no_match) the matcher starts over, and the rest of the
+   * chunk, starting at \c consumed, can be fed again.
+   *
+   * Bytes examined past the recognized value aren't consumed if they belong to the current chunk. The matcher doesn't
+   * store the input, so if they belong to a previous chunk, it's up to the caller to keep them: there are
+   * <tt>pending() - length</tt> of them, where \c pending() is taken before the call. On \c match_status::no_match,
+   * the byte that failed the match isn't consumed either (so \c consumed may be zero, then skip the byte).
+   *
+   * Values equal to each other are never recognized (see \ref is_ambiguous()), neither are empty values.
+   *
+   * \include matcher.cpp
+   */
+  template <typename E>
+  class matcher : validator<E>
+  {
+    using automaton_type = detail::keyword_automaton<E>;
+    using state_type     = typename automaton_type::state_type;
+
+  public:
+    /**
+     * \brief Constructs a matcher. The automaton is built on first construction for \c E.
+     */
+    matcher() : _automaton(&detail::default_keyword_automaton<E>()), _state(_automaton->initial_state()) {}
+
+    /**
+     * \brief Feeds the next chunk of the input.
+     *
+     * Stops at the first recognized value.
+     */
+    match_result<E> feed(std::string_view chunk) noexcept
+    {
+      // The state is kept in a local: the input is made of chars, which may alias the members as far as the compiler
+      // is concerned, so it would have to store them back on every byte otherwise.
+      const auto& automaton = *_automaton;
+      auto        state     = _state;
+
+      for (std::size_t i = 0; i < chunk.size(); ++i)
+      {
+        const auto next = automaton.next(state, chunk[i]);
+
+        if (next == automaton_type::dead_state)
+        {
+          _pending += i;
+          return complete(i);
+        }
+
+        state = next;
+
+        if (automaton_type::is_accepting(state))
+        {
+          _accepted        = state;
+          _accepted_length = _pending + i + 1;
+        }
+
+        if (automaton_type::is_final(state))
+        {
+          _pending += i + 1;
+          return complete(i + 1);
+        }
+      }
+
+      _state = state;
+      _pending += chunk.size();
+      return match_result<E>{match_status::incomplete, traits<E>::first, chunk.size(), _pending};
+    }
+
+    /**
+     * \brief Tells the matcher that the input is over and returns what the pending input turned out to be.
+     *
+     * There's nothing pending if the last \ref feed() didn't report \c match_status::incomplete, then it reports
+     * \c match_status::no_match with zero length.
+     */
+    match_result<E> finish() noexcept { return complete(0); }
+
+    /**
+     * \brief Drops the pending input, if any.
+     */
+    void reset() noexcept
+    {
+      _state           = _automaton->initial_state();
+      _pending         = 0;
+      _accepted        = automaton_type::dead_state;
+      _accepted_length = 0;
+    }
+
+    /**
+     * \brief Returns the number of bytes fed since the current value started.
+     */
+    std::size_t pending() const noexcept { return _pending; }
+
+    /**
+     * \brief Tells whether several items have equal values. Those values are never recognized.
+     */
+    bool is_ambiguous() const noexcept { return _automaton->is_ambiguous(); }
+
+  private:
+    match_result<E> complete(std::size_t consumed) noexcept
+    {
+      auto result = match_result<E>{match_status::no_match, traits<E>::first, consumed, _pending};
+
+      if (_accepted != automaton_type::dead_state)
+      {
+        const auto excess = _pending - _accepted_length;
+
+        result.status   = match_status::matched;
+        result.item     = get<E>(_automaton->item(_accepted));
+        result.consumed = consumed > excess ? consumed - excess : 0;
+        result.length   = _accepted_length;
+      }
+
+      reset();
+      return result;
+    }
+
+    const automaton_type* _automaton;
+    state_type            _state;
+    std::size_t           _pending         = 0;
+    state_type            _accepted        = automaton_type::dead_state;
+    std::size_t           _accepted_length = 0;
+  };
+
+  /** @}*/
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdint>
+#include <type_traits>
+
+
+namespace enum_utils
+{
+  /** \addtogroup conversionGroup
+   *  @{
+   */
+
+  /**
+   * \brief The default normalization policy of the reverse conversion: keys must match values exactly.
+   *
+   * A normalization policy tells which keys are considered equal. It folds every character of a key (\c fold()) and
+   * every byte of a machine word (\c fold_word()), the latter is used to hash keys a word at a time. The two must
+   * agree: folding characters first must not change the result of folding bytes. Only string values can be looked up
+   * with a policy other than \ref exact_match.
+   *
+   * \sa try_convert_to_enum()
+   * \sa conversion_table
+   */
+  struct exact_match
+  {
+    template <typename C>
+    static constexpr C fold(C c) noexcept
+    {
+      return c;
+    }
+
+    static constexpr std::uint64_t fold_word(std::uint64_t word) noexcept { return word; }
+  };
+
+  /**
+   * \brief A normalization policy which ignores the case of ASCII letters.
+   *
+   * \sa exact_match
+   */
+  struct case_insensitive
+  {
+    template <typename C>
+    static constexpr C fold(C c) noexcept
+    {
+      return c >= C('A') && c <= C('Z') ? static_cast<C>(c - C('A') + C('a')) : c;
+    }
+
+    // Sets the 0x20 bit of every byte in ['A', 'Z'] without branches. Adding to the lower seven bits never carries
+    // over to the next byte, and the bytes above 0x7f are excluded explicitly.
+    static constexpr std::uint64_t fold_word(std::uint64_t word) noexcept
+    {
+      constexpr auto ones = 0x0101010101010101ull;
+
+      const auto heptets   = word & (0x7f * ones);
+      const auto from_a    = heptets + (0x80 - 'A') * ones;
+      const auto past_z    = heptets + (0x80 - 'Z' - 1) * ones;
+      const auto uppercase = from_a & ~past_z & ~word & (0x80 * ones);
+
+      return word | (uppercase >> 2);
+    }
+  };
+
+  /**
+   * \brief A normalization policy which ignores the case of ASCII letters and doesn't tell '-' from '_'.
+   *
+   * Handy for names that are spelled differently in different places, like \c content-type and \c CONTENT_TYPE.
+   *
+   * \sa exact_match
+   */
+  struct case_and_separator_insensitive
+  {
+    template <typename C>
+    static constexpr C fold(C c) noexcept
+    {
+      return c == C('-') ? C('_') : case_insensitive::fold(c);
+    }
+
+    // Finds the bytes equal to '-' with the exact "has zero byte" test and flips them into '_'.
+    static constexpr std::uint64_t fold_word(std::uint64_t word) noexcept
+    {
+      constexpr auto ones = 0x0101010101010101ull;
+
+      const auto diff   = word ^ ('-' * ones);
+      const auto dashes = ~(((diff & (0x7f * ones)) + 0x7f * ones) | diff) & (0x80 * ones);
+
+      return case_insensitive::fold_word(word ^ ((dashes >> 7) * ('-' ^ '_')));
+    }
+  };
+
+  /** @}*/
+
+  namespace detail
+  {
+    template <typename Policy, typename = void>
+    struct is_normalization_policy : std::false_type
+    {
+    };
+
+    template <typename Policy>
+    struct is_normalization_policy<Policy, std::void_t<decltype(Policy::fold_word(std::uint64_t{}))>> : std::true_type
+    {
+    };
+  }
+}
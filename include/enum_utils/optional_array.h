@@ -0,0 +1,355 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "basic.h"
+#include "bitset.h"
+#include "traits.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace enum_utils
+{
+  /** \addtogroup containersGroup
+   * @{
+   */
+
+  /**
+   * \brief An associative container indexed by enumerations, where each item may or may not have a value.
+   *
+   * It's what <tt>\ref array<E, std::optional<T>></tt> is, but without the flag (and the padding that follows) next to
+   * every value. The presence of values is kept in a single \ref bitset, and the values themselves are kept in
+   * uninitialized storage, a slot per item. So the container is about as large as an \ref array of \c T.
+   *
+   * The interface follows \ref array where it makes sense. Only the items that have values are visited by the
+   * iterators, and \ref size() counts them with \c popcount.
+   *
+   * \include optional_array.cpp
+   */
+  template <typename E, typename T>
+  class optional_array : validator<E>
+  {
+  public:
+    // STL conventions.
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /**
+     * \brief A forward iterator over the values that are present, in the order of the items.
+     */
+    template <typename V>
+    class basic_iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = std::remove_const_t<V>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = V*;
+      using reference         = V&;
+
+      basic_iterator() noexcept = default;
+
+      reference operator*() const noexcept { return *_owner->slot(*_position); }
+      pointer operator->() const noexcept { return _owner->slot(*_position); }
+
+      /**
+       * \brief Returns the item of the value.
+       */
+      E item() const noexcept { return *_position; }
+
+      basic_iterator& operator++() noexcept
+      {
+        ++_position;
+        return *this;
+      }
+
+      basic_iterator operator++(int) noexcept
+      {
+        auto tmp = *this;
+        ++_position;
+        return tmp;
+      }
+
+      bool operator==(const basic_iterator& other) const noexcept { return _position == other._position; }
+      bool operator!=(const basic_iterator& other) const noexcept { return _position != other._position; }
+
+    private:
+      friend class optional_array;
+
+      using owner_type = std::conditional_t<std::is_const<V>::value, const optional_array, optional_array>;
+
+      basic_iterator(owner_type* owner, typename bitset<E>::const_iterator position) noexcept :
+        _owner(owner),
+        _position(position)
+      {
+      }
+
+      owner_type* _owner = nullptr;
+      typename bitset<E>::const_iterator _position;
+    };
+
+    using iterator       = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+
+    /**
+     * \brief Constructs an empty container.
+     */
+    optional_array() noexcept = default;
+
+    /**
+     * \brief Constructs a container with the listed values.
+     */
+    optional_array(std::initializer_list<std::pair<E, T>> values)
+    {
+      // The destructor isn't run if a constructor throws, so the values constructed so far are destroyed here.
+      try
+      {
+        for (const auto& value : values)
+          emplace(value.first, value.second);
+      }
+      catch (...)
+      {
+        clear();
+        throw;
+      }
+    }
+
+    optional_array(const optional_array& other)
+    {
+      try
+      {
+        for (auto e : other._present)
+          construct(e, *other.slot(e));
+      }
+      catch (...)
+      {
+        clear();
+        throw;
+      }
+    }
+
+    optional_array(optional_array&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      try
+      {
+        for (auto e : other._present)
+          construct(e, std::move(*other.slot(e)));
+      }
+      catch (...)
+      {
+        clear();
+        throw;
+      }
+    }
+
+    optional_array& operator=(const optional_array& other)
+    {
+      if (this != &other)
+      {
+        clear();
+
+        for (auto e : other._present)
+          construct(e, *other.slot(e));
+      }
+
+      return *this;
+    }
+
+    optional_array& operator=(optional_array&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      if (this != &other)
+      {
+        clear();
+
+        for (auto e : other._present)
+          construct(e, std::move(*other.slot(e)));
+      }
+
+      return *this;
+    }
+
+    ~optional_array() { clear(); }
+
+    // Modifiers.
+
+    /**
+     * \brief Constructs the value of \c e from \c args, destroying the previous one, if any.
+     */
+    template <typename... Args>
+    T& emplace(E e, Args&&... args)
+    {
+      erase(e);
+      return construct(e, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Destroys the value of \c e, if any.
+     *
+     * \returns Whether there was a value.
+     */
+    bool erase(E e) noexcept
+    {
+      if (!_present.test(e))
+        return false;
+
+      slot(e)->~T();
+      _present.reset(e);
+      return true;
+    }
+
+    /**
+     * \brief Destroys all the values.
+     */
+    void clear() noexcept
+    {
+      if constexpr (!std::is_trivially_destructible<T>::value)
+      {
+        for (auto e : _present)
+          slot(e)->~T();
+      }
+
+      _present.reset();
+    }
+
+    // Lookup.
+    bool contains(E e) const noexcept { return _present.test(e); }
+
+    /**
+     * \brief Returns a pointer to the value of \c e, or \c nullptr if there's none.
+     */
+    T* get_if(E e) noexcept { return contains(e) ? slot(e) : nullptr; }
+
+    /**
+     * \copydoc get_if()
+     */
+    const T* get_if(E e) const noexcept { return contains(e) ? slot(e) : nullptr; }
+
+    /**
+     * \brief Returns the set of the items that have values.
+     */
+    const bitset<E>& items() const noexcept { return _present; }
+
+    // Element access. The value of `e` must be present, unless it's `at()` which throws otherwise.
+    reference operator[](E e) noexcept { return *slot(e); }
+    const_reference operator[](E e) const noexcept { return *slot(e); }
+
+    reference at(E e) { return *checked_slot(e); }
+    const_reference at(E e) const { return *checked_slot(e); }
+
+    // Iterators.
+    iterator begin() noexcept { return iterator{this, _present.begin()}; }
+    iterator end() noexcept { return iterator{this, _present.end()}; }
+
+    const_iterator begin() const noexcept { return const_iterator{this, _present.begin()}; }
+    const_iterator end() const noexcept { return const_iterator{this, _present.end()}; }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Capacity.
+    size_type size() const noexcept { return _present.count(); }
+    bool empty() const noexcept { return _present.none(); }
+
+    static constexpr size_type max_size() noexcept { return enum_utils::size<E>(); }
+
+    friend bool operator==(const optional_array& lhs, const optional_array& rhs)
+    {
+      if (lhs._present != rhs._present)
+        return false;
+
+      for (auto e : lhs._present)
+      {
+        if (!(*lhs.slot(e) == *rhs.slot(e)))
+          return false;
+      }
+
+      return true;
+    }
+
+    friend bool operator!=(const optional_array& lhs, const optional_array& rhs) { return !(lhs == rhs); }
+
+    // Lexicographical, item by item, as for an `array<E, std::optional<T>>`: no value is less than any value.
+    friend bool operator<(const optional_array& lhs, const optional_array& rhs)
+    {
+      for (auto e : lhs._present | rhs._present)
+      {
+        if (!lhs.contains(e))
+          return true;
+
+        if (!rhs.contains(e))
+          return false;
+
+        if (*lhs.slot(e) < *rhs.slot(e))
+          return true;
+
+        if (*rhs.slot(e) < *lhs.slot(e))
+          return false;
+      }
+
+      return false;
+    }
+
+    friend bool operator>(const optional_array& lhs, const optional_array& rhs) { return rhs < lhs; }
+    friend bool operator<=(const optional_array& lhs, const optional_array& rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const optional_array& lhs, const optional_array& rhs) { return !(lhs < rhs); }
+
+  private:
+    struct alignas(T) storage
+    {
+      unsigned char bytes[sizeof(T)];
+    };
+
+    T* slot(E e) noexcept { return std::launder(reinterpret_cast<T*>(&_slots[index(e)])); }
+    const T* slot(E e) const noexcept { return std::launder(reinterpret_cast<const T*>(&_slots[index(e)])); }
+
+    template <typename... Args>
+    T& construct(E e, Args&&... args)
+    {
+      auto result = ::new (static_cast<void*>(&_slots[index(e)])) T(std::forward<Args>(args)...);
+      _present.set(e);
+      return *result;
+    }
+
+    const T* checked_slot(E e) const
+    {
+      if (!contains(e))
+        throw std::out_of_range{"The item has no value"};
+
+      return slot(e);
+    }
+
+    T* checked_slot(E e) { return const_cast<T*>(static_cast<const optional_array&>(*this).checked_slot(e)); }
+
+    bitset<E> _present;
+    storage _slots[enum_utils::size<E>()];
+  };
+
+  /** @}*/
+}
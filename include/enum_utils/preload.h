@@ -0,0 +1,154 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "conversion.h"
+
+#include <chrono>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+
+namespace enum_utils
+{
+  /** \addtogroup conversionGroup
+   * @{
+   */
+
+  /**
+   * \brief The outcome of preloading conversion tables for a pair of \c E and \c T.
+   *
+   * \sa preload_all()
+   */
+  struct preload_result
+  {
+    std::type_index          enum_type;
+    std::type_index          value_type;
+    std::chrono::nanoseconds construction_time;
+  };
+
+  /**
+   * \brief Eagerly builds the conversion tables between \c E and \c T.
+   *
+   * Normally, the tables used by \ref convert_to_value() and \ref convert_to_enum() are built on first invocation,
+   * which stalls whoever happens to invoke them first. Preloading moves that to a moment of your choosing (say, startup).
+   * Once the tables are built, accessing them boils down to a pointer load.
+   *
+   * \returns The time it took to construct the tables, no matter whether it was this call or some earlier conversion
+   * that actually built them.
+   * \sa preload_all()
+   */
+  template <typename E, typename T>
+  std::chrono::nanoseconds preload()
+  {
+    const auto& table = detail::default_conversion_table<E, T>();
+    auto        result =
+        std::chrono::nanoseconds{detail::conversion_storage<E, T>::construction_time.load(std::memory_order_relaxed)};
+
+    if constexpr (detail::is_hashable<T>::value)
+      result += table.preload();
+
+    return result;
+  }
+
+  namespace detail
+  {
+    struct preload_entry
+    {
+      std::type_index enum_type;
+      std::type_index value_type;
+      std::chrono::nanoseconds (*preload)();
+    };
+
+    struct preload_registry
+    {
+      std::mutex                 mutex;
+      std::vector<preload_entry> entries;
+    };
+
+    inline preload_registry& get_preload_registry()
+    {
+      static auto registry = preload_registry{};
+      return registry;
+    }
+
+    template <typename E, typename T>
+    bool register_conversion()
+    {
+      auto& registry = get_preload_registry();
+      auto  lock     = std::lock_guard<std::mutex>{registry.mutex};
+
+      registry.entries.push_back(preload_entry{typeid(E), typeid(T), &preload<E, T>});
+      return true;
+    }
+
+    template <typename E, typename T>
+    struct conversion_registration;
+  }
+
+  /**
+   * \brief Eagerly builds the conversion tables for all the registered pairs of \c E and \c T.
+   *
+   * A pair is registered with \ref ENUM_UTILS_REGISTER_CONVERSION().
+   *
+   * \returns The construction time of the tables for each of the pairs (in order of registration).
+   * \sa preload()
+   */
+  inline std::vector<preload_result> preload_all()
+  {
+    auto& registry = detail::get_preload_registry();
+    auto  entries  = std::vector<detail::preload_entry>{};
+
+    {
+      auto lock = std::lock_guard<std::mutex>{registry.mutex};
+      entries   = registry.entries;
+    }
+
+    auto result = std::vector<preload_result>{};
+    result.reserve(entries.size());
+
+    for (const auto& entry : entries)
+      result.push_back(preload_result{entry.enum_type, entry.value_type, entry.preload()});
+
+    return result;
+  }
+
+  /** @}*/
+}
+
+/** \addtogroup conversionGroup
+ *  @{
+ */
+
+/**
+ * \brief Registers conversion between \c E and \c T to be built by \ref enum_utils::preload_all().
+ *
+ * The macro can be put into a header along with \ref ENUM_UTILS_DEFINE_CONVERSION() macros: the pair is registered only
+ * once no matter how many units include it.
+ */
+#define ENUM_UTILS_REGISTER_CONVERSION(E, T)                                                                           \
+  template <>                                                                                                          \
+  struct enum_utils::detail::conversion_registration<E, T>                                                             \
+  {                                                                                                                    \
+    static inline const bool registered = enum_utils::detail::register_conversion<E, T>();                            \
+  };
+
+/** @}*/
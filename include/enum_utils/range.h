@@ -22,6 +22,8 @@
 #include "iterator.h"
 #include "traits.h"
 
+#include <cstddef>
+
 
 namespace enum_utils
 {
@@ -31,16 +33,24 @@ namespace enum_utils
 
   /**
    * \brief The class is useful mostly for range-based for loops.
+   *
+   * It's a sized random access range, so it works with the standard algorithms (the parallel ones included) and
+   * C++20 ranges.
    */
   template <typename E>
   struct range : validator<E>
   {
-    range(E _first = traits<E>::first, E _last = traits<E>::last) : _first(_first), _last(_last) {}
+    constexpr range(E _first = traits<E>::first, E _last = traits<E>::last) noexcept : _first(_first), _last(_last) {}
+
+    constexpr iterator<E> begin() const noexcept { return iterator<E>{_first}; }
+    constexpr iterator<E> end() const noexcept { return ++iterator<E>{_last}; }
+    constexpr iterator<E> cbegin() const noexcept { return begin(); }
+    constexpr iterator<E> cend() const noexcept { return end(); }
+
+    constexpr std::size_t size() const noexcept { return index(_last) - index(_first) + 1; }
+    constexpr bool empty() const noexcept { return false; }
 
-    iterator<E> begin() const noexcept { return iterator<E>{_first}; }
-    iterator<E> end() const noexcept { return ++iterator<E>{_last}; }
-    iterator<E> cbegin() const noexcept { return begin(); }
-    iterator<E> cend() const noexcept { return end(); }
+    constexpr E operator[](std::size_t n) const noexcept { return begin()[static_cast<std::ptrdiff_t>(n)]; }
 
     /** \privatesection */
     E _first;
@@ -21,7 +21,9 @@
 #include "basic.h"
 #include "traits.h"
 
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 
 namespace enum_utils
@@ -76,7 +78,7 @@ namespace enum_utils
       using type = std::index_sequence<0>;
     };
 
-    template <typename E, size_t... indices>
+    template <typename E, std::size_t... indices>
     constexpr auto make_sequence_type(std::index_sequence<indices...>) -> sequence<E, get<E, indices>()...>;
   }
 
@@ -87,7 +89,7 @@ namespace enum_utils
    * An example of usage can be found in \ref variadic.h.
    */
   template <typename E>
-  using sequence_type = decltype(detail::make_sequence_type<E>(detail::index_sequence_maker<size<E>()>::type{}));
+  using sequence_type = decltype(detail::make_sequence_type<E>(typename detail::index_sequence_maker<size<E>()>::type{}));
 
   /** @}*/
 }
@@ -0,0 +1,200 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "array.h"
+#include "basic.h"
+#include "traits.h"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // Moves the `k`-th column out of the rows generated beforehand, to be used with `array::make()`.
+    template <typename E, std::size_t k>
+    struct column_generator
+    {
+      template <E e>
+      struct impl
+      {
+        template <typename Rows>
+        constexpr auto operator()(Rows& rows) const
+        {
+          return std::get<k>(std::move(rows[e]));
+        }
+      };
+    };
+  }
+
+  /** \addtogroup containersGroup
+   * @{
+   */
+
+  /**
+   * \brief A table with a row per item of \c E, stored column by column.
+   *
+   * Every column is an \ref array of its own, so a loop over a single column touches that column only, just as if it
+   * were a separate array. Yet the table is defined in one place: a single generator produces all the columns of a
+   * row, either at compile time or at runtime.
+   *
+   * The columns are accessed by their positions, either as whole arrays (\ref column()) or element by element
+   * (\ref get()). A row is accessed as a tuple of references to its elements (\ref row()).
+   *
+   * \include soa_table.cpp
+   */
+  template <typename E, typename... Columns>
+  class soa_table : validator<E>
+  {
+  public:
+    /**
+     * \brief A tuple of the values of a row. That's what generators return.
+     */
+    using row_type = std::tuple<Columns...>;
+
+    /**
+     * \brief A tuple of references to the elements of a row.
+     */
+    using reference = std::tuple<Columns&...>;
+
+    /**
+     * \brief A tuple of const references to the elements of a row.
+     */
+    using const_reference = std::tuple<const Columns&...>;
+
+    /**
+     * \brief The type of the column number \c k.
+     */
+    template <std::size_t k>
+    using column_type = array<E, std::tuple_element_t<k, row_type>>;
+
+    /**
+     * \brief Generates the table.
+     *
+     * By default, all the elements are value initialized in place, so the columns may be of types that can be neither
+     * copied nor moved. A custom generator produces a row (a \c std::tuple, or any other type \c std::get() works
+     * for) of the item it's instantiated for. It's invoked once for every item, and then the elements of the rows are
+     * moved into the columns, so the columns have to be move constructible. Either way, the table is generated at
+     * compile time if the generator allows.
+     */
+    template <template <E> typename TGenerator = detail::simple_generator<E, row_type>::template impl>
+    static constexpr soa_table make()
+    {
+      constexpr auto first = traits<E>::first;
+
+      if constexpr (std::is_same<TGenerator<first>, default_generator<first>>::value)
+      {
+        return soa_table{};
+      }
+      else
+      {
+        auto rows = array<E, decltype(TGenerator<first>{}())>::template make<TGenerator>();
+        return make_columns(rows, std::index_sequence_for<Columns...>{});
+      }
+    }
+
+    /**
+     * \brief Returns the column number \c k.
+     */
+    template <std::size_t k>
+    constexpr column_type<k>& column() noexcept
+    {
+      return std::get<k>(_columns);
+    }
+
+    /**
+     * \copydoc column()
+     */
+    template <std::size_t k>
+    constexpr const column_type<k>& column() const noexcept
+    {
+      return std::get<k>(_columns);
+    }
+
+    /**
+     * \brief Returns the element of \c e in the column number \c k.
+     */
+    template <std::size_t k>
+    constexpr std::tuple_element_t<k, row_type>& get(E e) noexcept
+    {
+      return column<k>()[e];
+    }
+
+    /**
+     * \copydoc get()
+     */
+    template <std::size_t k>
+    constexpr const std::tuple_element_t<k, row_type>& get(E e) const noexcept
+    {
+      return column<k>()[e];
+    }
+
+    /**
+     * \brief Returns the row of \c e. A tuple can be assigned to it to update the whole row.
+     */
+    constexpr reference row(E e) noexcept { return row(e, std::index_sequence_for<Columns...>{}); }
+
+    /**
+     * \copydoc row()
+     */
+    constexpr const_reference row(E e) const noexcept { return row(e, std::index_sequence_for<Columns...>{}); }
+
+    /**
+     * \brief Returns the number of rows.
+     */
+    static constexpr std::size_t size() noexcept { return enum_utils::size<E>(); }
+
+  private:
+    using columns_type = std::tuple<array<E, Columns>...>;
+
+    template <E e>
+    using default_generator = typename detail::simple_generator<E, row_type>::template impl<e>;
+
+    constexpr soa_table() : _columns{} {}
+
+    constexpr explicit soa_table(columns_type&& columns) : _columns(std::move(columns)) {}
+
+    template <typename Rows, std::size_t... ks>
+    static constexpr soa_table make_columns(Rows& rows, std::index_sequence<ks...>)
+    {
+      return soa_table{
+          columns_type{column_type<ks>::template make<detail::column_generator<E, ks>::template impl>(rows)...}};
+    }
+
+    template <std::size_t... ks>
+    constexpr reference row(E e, std::index_sequence<ks...>) noexcept
+    {
+      return reference{get<ks>(e)...};
+    }
+
+    template <std::size_t... ks>
+    constexpr const_reference row(E e, std::index_sequence<ks...>) const noexcept
+    {
+      return const_reference{get<ks>(e)...};
+    }
+
+    columns_type _columns;
+  };
+
+  /** @}*/
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "basic.h"
+#include "bits.h"
+#include "static_sort.h"
+#include "traits.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    // The items of an enumeration with gaps are sorted by their values, and the indices are the ranks of the values.
+    // Every value is represented by its offset from the smallest one: the offsets are unsigned, and a difference of
+    // underlying values converted to 64 bits is the offset, no matter whether the underlying type is signed.
+    template <typename E>
+    constexpr std::uint64_t item_offset(E e, E first) noexcept
+    {
+      using underlying_type = std::underlying_type_t<E>;
+      return static_cast<std::uint64_t>(static_cast<underlying_type>(e)) -
+             static_cast<std::uint64_t>(static_cast<underlying_type>(first));
+    }
+
+    template <typename E, std::size_t n>
+    using sparse_entries = std::array<static_entry<E, std::uint64_t>, n>;
+
+    template <typename E, std::size_t n>
+    constexpr sparse_entries<E, n> make_sparse_entries(const std::array<E, n>& items)
+    {
+      // Flipping the sign bit orders signed values the same way as unsigned ones.
+      constexpr auto sign = std::is_signed<std::underlying_type_t<E>>::value ? std::uint64_t{1} << 63 : 0;
+
+      auto result = sparse_entries<E, n>{};
+
+      for (std::size_t i = 0; i < n; ++i)
+        result[i] = {item_offset(items[i], static_cast<E>(0)) ^ sign, items[i]};
+
+      sort_entries<static_comparator<std::uint64_t>>(result);
+
+      for (std::size_t i = n; i-- > 0;)
+        result[i].value -= result[0].value;
+
+      return result;
+    }
+
+    template <typename E, std::size_t n>
+    constexpr bool has_duplicates(const sparse_entries<E, n>& entries)
+    {
+      for (std::size_t i = 1; i < n; ++i)
+      {
+        if (entries[i].value == entries[i - 1].value)
+          return true;
+      }
+
+      return false;
+    }
+
+    // Small spans of values are covered by a table holding the index of every value within the span.
+    template <std::size_t n, std::uint64_t span>
+    struct direct_sparse_index
+    {
+      template <typename Entries>
+      constexpr explicit direct_sparse_index(const Entries& entries)
+      {
+        for (std::size_t i = 0; i < n; ++i)
+          slots[entries[i].value] = static_cast<smallest_unsigned_t<n - 1>>(i);
+      }
+
+      constexpr std::size_t operator()(std::uint64_t offset) const noexcept { return slots[offset]; }
+
+      smallest_unsigned_t<n - 1> slots[span] = {};
+    };
+
+    // Larger spans are covered by a bitmap of the values, a bit per value. The index of a value is the number of bits
+    // set before it: the number of the bits set before every word is stored, the rest is counted within the word.
+    template <std::size_t n, std::uint64_t span>
+    struct bitmap_sparse_index
+    {
+      static constexpr std::size_t words = word_count(span);
+
+      template <typename Entries>
+      constexpr explicit bitmap_sparse_index(const Entries& entries)
+      {
+        for (std::size_t i = 0; i < n; ++i)
+          bits[entries[i].value / word_bits] |= std::uint64_t{1} << (entries[i].value % word_bits);
+
+        auto rank = std::size_t{0};
+
+        for (std::size_t i = 0; i < words; ++i)
+        {
+          ranks[i] = static_cast<smallest_unsigned_t<n>>(rank);
+          rank += popcount(bits[i]);
+        }
+      }
+
+      constexpr std::size_t operator()(std::uint64_t offset) const noexcept
+      {
+        const auto word = static_cast<std::size_t>(offset / word_bits);
+        return ranks[word] + popcount(bits[word] & low_bits(offset % word_bits));
+      }
+
+      std::uint64_t bits[words]           = {};
+      smallest_unsigned_t<n> ranks[words] = {};
+    };
+
+    // The values that are too sparse for a bitmap are searched for, in O(log n).
+    template <typename E, std::size_t n>
+    struct sorted_sparse_index
+    {
+      constexpr explicit sorted_sparse_index(const sparse_entries<E, n>& entries) : entries(entries) {}
+
+      constexpr std::size_t operator()(std::uint64_t offset) const noexcept
+      {
+        return upper_bound<static_comparator<std::uint64_t>>(entries, offset) - 1;
+      }
+
+      sparse_entries<E, n> entries;
+    };
+
+    constexpr std::uint64_t sparse_direct_limit(std::size_t n) noexcept { return 4 * std::uint64_t{n} + 1024; }
+
+    // A bitmap takes up to 16 words per item, so a few items spread wide apart don't get a table of megabytes.
+    constexpr std::uint64_t sparse_bitmap_limit(std::size_t n) noexcept
+    {
+      constexpr auto max_span = std::uint64_t{1} << 22;
+      const auto     span     = 16 * word_bits * std::uint64_t{n};
+
+      return span < max_span ? span : max_span;
+    }
+
+    template <typename E, std::size_t n, std::uint64_t last_offset>
+    using sparse_index_t = std::conditional_t<
+        last_offset < sparse_direct_limit(n),
+        direct_sparse_index<n, last_offset + 1>,
+        std::conditional_t<
+            last_offset < sparse_bitmap_limit(n),
+            bitmap_sparse_index<n, last_offset + 1>,
+            sorted_sparse_index<E, n>>>;
+
+    template <typename E, E... es>
+    struct sparse_traits_helper : type_validator<E>
+    {
+      using underlying_type = std::underlying_type_t<E>;
+
+      static_assert(sizeof...(es) > 0, "No items.");
+
+      static constexpr auto entries = make_sparse_entries(std::array<E, sizeof...(es)>{{es...}});
+
+      static_assert(!has_duplicates(entries), "The items must have distinct values.");
+
+      static constexpr auto size  = sizeof...(es);
+      static constexpr auto first = entries[0].item;
+      static constexpr auto last  = entries[size - 1].item;
+
+      static constexpr auto items = [] {
+        auto result = std::array<E, size>{};
+
+        for (std::size_t i = 0; i < size; ++i)
+          result[i] = entries[i].item;
+
+        return result;
+      }();
+
+      static constexpr auto lookup = sparse_index_t<E, size, entries[size - 1].value>{entries};
+
+      static constexpr std::size_t index(E e) noexcept { return lookup(item_offset(e, first)); }
+    };
+  }
+}
+
+/** \addtogroup traitsGroup
+ *  @{
+ */
+
+/**
+ * \brief Defines traits for an enumeration with gaps between its items, listing the items
+ *
+ * The items are passed qualified (<tt>E::a, E::b</tt>) and in any order, but their values must be distinct. The
+ * library then works with the listed items only: \ref size() is the number of the items, \ref range and
+ * \ref sequence_type traverse the items, \ref array has an element per item, and so on.
+ *
+ * The indices are the ranks of the values, and both \ref get() and \ref index() are O(1). The former reads an array
+ * of the items. The latter depends on how far apart the values are: within a small span, it's a single lookup into a
+ * table that covers the span; within a larger one (up to 4M values), it's a lookup into a bitmap of the values and a
+ * \c popcount. Values that are even further apart are found with a binary search.
+ *
+ * \sa ENUM_UTILS_DEFINE_TRAITS()
+ */
+#define ENUM_UTILS_DEFINE_TRAITS_ITEMS(E, ...)                                                                         \
+  template <>                                                                                                          \
+  struct enum_utils::traits<E> : enum_utils::detail::sparse_traits_helper<E, __VA_ARGS__>                              \
+  {                                                                                                                    \
+  };
+
+/** @}*/
@@ -0,0 +1,191 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "array.h"
+#include "exceptions.h"
+#include "static_sort.h"
+#include "traits.h"
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+
+namespace enum_utils
+{
+  /** \addtogroup conversionGroup
+   * @{
+   */
+
+  namespace detail
+  {
+    template <typename E, E e, typename T>
+    constexpr T static_convert();
+  }
+
+  /**
+   * \brief This functor is used to convert each item of enum \c E to a value of type \c T at compile time.
+   *
+   * It's the compile time counterpart of \ref conversion_generator. You can provide your specializations of the class
+   * as an alternate way of conversion (instead of defining an \ref ENUM_UTILS_DEFINE_STATIC_CONVERSION() macro for each
+   * of the items of \c E).
+   * \sa static_convert_to_value()
+   */
+  template <typename E, typename T>
+  struct static_conversion_generator : validator<E>
+  {
+    template <E e>
+    struct impl
+    {
+      constexpr T operator()() const { return detail::static_convert<E, e, T>(); }
+    };
+  };
+
+  namespace detail
+  {
+    template <typename E, typename T>
+    struct static_conversion_table
+    {
+      static constexpr auto values = array<E, T>::template make<static_conversion_generator<E, T>::template impl>();
+    };
+
+    template <typename E, typename T>
+    struct static_reverse_lookup_table
+    {
+      using entry      = static_entry<E, T>;
+      using comparator = static_comparator<T>;
+      using entries    = std::array<entry, size<E>()>;
+
+      static constexpr entries make_entries()
+      {
+        auto result = entries{};
+
+        for (std::size_t i = 0; i < result.size(); ++i)
+          result[i] = entry{static_conversion_table<E, T>::values[get<E>(i)], get<E>(i)};
+
+        sort_entries<comparator>(result);
+        return result;
+      }
+
+      static constexpr bool is_ambiguous()
+      {
+        for (std::size_t i = 1; i < sorted.size(); ++i)
+        {
+          if (comparator::equal(sorted[i - 1].value, sorted[i].value))
+            return true;
+        }
+
+        return false;
+      }
+
+      static constexpr std::pair<E, bool> find(const T& value)
+      {
+        const auto first = lower_bound<comparator>(sorted, value);
+
+        return first < sorted.size() && comparator::equal(sorted[first].value, value)
+                   ? std::make_pair(sorted[first].item, true)
+                   : std::make_pair(traits<E>::first, false);
+      }
+
+      static constexpr entries sorted = make_entries();
+
+      static_assert(!is_ambiguous(), "Ambiguous reverse conversion (multiple enum entries match the same value)");
+    };
+  }
+
+  /**
+   * \brief Converts the passed enum value to the corresponding value of type \c T at compile time.
+   *
+   * The compile time counterpart of \ref convert_to_value(). The values are generated by
+   * \ref static_conversion_generator, so they have to be of a literal type (\c std::string_view and C strings are
+   * the most common choices). All the values are computed at compile time and stored as constant data, so the
+   * conversion is a mere indexed load with no initialization whatsoever:
+   *
+   * \include static_conversion.cpp
+   *
+   * \sa static_conversion_generator
+   * \sa try_static_convert_to_enum()
+   */
+  template <typename T, typename E>
+  constexpr const T& static_convert_to_value(E e) noexcept
+  {
+    return detail::static_conversion_table<E, T>::values[e];
+  }
+
+  /**
+   * \brief Tries to convert a passed value of type \c T back to the corresponding enum value at compile time.
+   *
+   * The compile time counterpart of \ref try_convert_to_enum(). The reverse index (values sorted along with their
+   * items) is computed at compile time too, so the lookup is a binary search over constant data. C strings are matched
+   * by their contents. Ambiguous conversions are reported at compile time.
+   *
+   * \returns \c std::pair<E, true> on successful conversion or \c std::pair<_first, false> otherwise.
+   * \sa static_convert_to_enum()
+   */
+  template <typename E, typename T>
+  constexpr std::pair<E, bool> try_static_convert_to_enum(const T& t)
+  {
+    return detail::static_reverse_lookup_table<E, std::decay_t<const T>>::find(t);
+  }
+
+  /**
+   * \brief Converts a passed value of type \c T back to the corresponding enum value at compile time.
+   *
+   * Essentially same as \ref try_static_convert_to_enum(), but it always either returns a value of \c E, or throws
+   * \ref bad_conversion if it failed to find one.
+   *
+   * \throws bad_conversion
+   * \sa try_static_convert_to_enum()
+   */
+  template <typename E, typename T>
+  constexpr E static_convert_to_enum(const T& t)
+  {
+    const auto result = try_static_convert_to_enum<E>(t);
+
+    if (!result.second)
+      throw bad_conversion{"No enum value matches the key"};
+
+    return result.first;
+  }
+
+  /** @}*/
+}
+
+/** \addtogroup conversionGroup
+ *  @{
+ */
+
+/**
+ * \brief Defines compile time conversion from a value of \c E to a value of a literal type.
+ *
+ * The compile time counterpart of \ref ENUM_UTILS_DEFINE_CONVERSION(). If an item is omitted, you get a compilation
+ * error rather than a link error. Another way of providing the conversion is specializing
+ * \ref enum_utils::static_conversion_generator.
+ */
+#define ENUM_UTILS_DEFINE_STATIC_CONVERSION(E, V)                                                                      \
+  template <>                                                                                                          \
+  constexpr std::decay_t<decltype(V)>                                                                                  \
+      enum_utils::detail::static_convert<std::decay_t<decltype(E)>, E, std::decay_t<decltype(V)>>()                    \
+  {                                                                                                                    \
+    return V;                                                                                                          \
+  }
+
+/** @}*/
@@ -0,0 +1,175 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    template <typename T>
+    struct static_comparator
+    {
+      static constexpr bool less(const T& lhs, const T& rhs) { return lhs < rhs; }
+      static constexpr bool equal(const T& lhs, const T& rhs) { return lhs == rhs; }
+    };
+
+    // Strings are compared with a plain loop: it's evaluated at compile time several times faster than
+    // `std::char_traits`, which matters when large enums are sorted. C strings are compared by their contents, not by
+    // their addresses.
+    template <typename C>
+    constexpr int compare_strings(const C* lhs, std::size_t lhs_length, const C* rhs, std::size_t rhs_length)
+    {
+      for (std::size_t i = 0; i < lhs_length && i < rhs_length; ++i)
+      {
+        if (lhs[i] != rhs[i])
+          return lhs[i] < rhs[i] ? -1 : 1;
+      }
+
+      return lhs_length < rhs_length ? -1 : lhs_length > rhs_length ? 1 : 0;
+    }
+
+    template <typename C>
+    constexpr std::size_t string_length(const C* s)
+    {
+      auto result = std::size_t{0};
+
+      while (s[result] != C{})
+        ++result;
+
+      return result;
+    }
+
+    template <typename C, typename Traits>
+    struct static_comparator<std::basic_string_view<C, Traits>>
+    {
+      using string_view = std::basic_string_view<C, Traits>;
+
+      static constexpr bool less(string_view lhs, string_view rhs)
+      {
+        return compare_strings(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+      }
+
+      static constexpr bool equal(string_view lhs, string_view rhs)
+      {
+        return compare_strings(lhs.data(), lhs.size(), rhs.data(), rhs.size()) == 0;
+      }
+    };
+
+    template <typename C>
+    struct static_comparator<const C*>
+    {
+      static constexpr bool less(const C* lhs, const C* rhs)
+      {
+        return compare_strings(lhs, string_length(lhs), rhs, string_length(rhs)) < 0;
+      }
+
+      static constexpr bool equal(const C* lhs, const C* rhs)
+      {
+        return compare_strings(lhs, string_length(lhs), rhs, string_length(rhs)) == 0;
+      }
+    };
+
+    template <typename E, typename T>
+    struct static_entry
+    {
+      T value;
+      E item;
+    };
+
+    // Bottom-up merge sort: `std::sort` isn't constexpr yet, and the number of comparisons matters here since it's
+    // limited by the compiler when evaluated at compile time. The sort is stable, so equal values keep the order
+    // of their items.
+    template <typename Comparator, typename Entry, std::size_t n>
+    constexpr void sort_entries(std::array<Entry, n>& entries)
+    {
+      auto buffer = std::array<Entry, n>{};
+
+      for (std::size_t width = 1; width < n; width *= 2)
+      {
+        for (std::size_t first = 0; first < n; first += 2 * width)
+        {
+          const auto middle = first + width < n ? first + width : n;
+          const auto last   = middle + width < n ? middle + width : n;
+
+          auto lhs = first;
+          auto rhs = middle;
+
+          for (auto i = first; i < last; ++i)
+          {
+            if (lhs < middle && (rhs == last || !Comparator::less(entries[rhs].value, entries[lhs].value)))
+              buffer[i] = entries[lhs++];
+            else
+              buffer[i] = entries[rhs++];
+          }
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+          entries[i] = buffer[i];
+      }
+    }
+
+    // Returns the index of the first entry whose value isn't less than `value`.
+    template <typename Comparator, typename Entry, std::size_t n, typename T>
+    constexpr std::size_t lower_bound(const std::array<Entry, n>& entries, const T& value)
+    {
+      auto first = std::size_t{0};
+      auto last  = n;
+
+      while (first < last)
+      {
+        const auto middle = first + (last - first) / 2;
+
+        if (Comparator::less(entries[middle].value, value))
+          first = middle + 1;
+        else
+          last = middle;
+      }
+
+      return first;
+    }
+
+    // Returns the index of the first entry whose value is greater than `value`. The search range is halved without
+    // branching on the comparison, so the compiler emits a conditional move rather than a hard to predict jump: it
+    // makes a difference at runtime, where the values being searched for are random.
+    template <typename Comparator, typename Entry, std::size_t n, typename T>
+    constexpr std::size_t upper_bound(const std::array<Entry, n>& entries, const T& value)
+    {
+      if (n == 0)
+        return 0;
+
+      auto first  = std::size_t{0};
+      auto length = n;
+
+      while (length > 1)
+      {
+        const auto half = length / 2;
+
+        first = Comparator::less(value, entries[first + half].value) ? first : first + half;
+        length -= half;
+      }
+
+      return first + !Comparator::less(value, entries[first].value);
+    }
+  }
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "array.h"
+#include "basic.h"
+#include "conversion.h"
+#include "sequence.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+
+namespace enum_utils
+{
+  /** \addtogroup conversionGroup
+   * @{
+   */
+
+  /**
+   * \brief Compact storage of the string values of \c E.
+   *
+   * All the values are packed one after another into a single buffer, and an offset and a length are kept for every
+   * item. Unlike an \ref array of strings, there are only two heap blocks regardless of the number and the length of
+   * values, so formatting many items touches as little memory as possible.
+   *
+   * The pool is built either from \ref conversion_generator, one value at a time (so all the values never coexist as
+   * separate strings), or from an array of strings.
+   *
+   * \sa append_name()
+   * \sa name_view()
+   */
+  template <typename E, typename C = char>
+  class string_pool : validator<E>
+  {
+  public:
+    using string_type = std::basic_string<C>;
+    using view_type   = std::basic_string_view<C>;
+
+    /**
+     * \brief Builds the pool using \ref conversion_generator.
+     */
+    string_pool() { add_all(sequence_type<E>{}); }
+
+    /**
+     * \brief Builds the pool from an array of values.
+     */
+    explicit string_pool(const array<E, string_type>& values)
+    {
+      for (std::size_t i = 0; i < values.size(); ++i)
+        add(get<E>(i), values[get<E>(i)]);
+    }
+
+    /**
+     * \brief Returns the value of \c e. The view stays valid as long as the pool exists.
+     */
+    view_type view(E e) const noexcept
+    {
+      const auto& entry = _entries[e];
+      return view_type{_buffer.data() + entry.offset, entry.length};
+    }
+
+    /**
+     * \brief Copies the value of \c e to \c out, which must have room for it. No terminating null is written.
+     *
+     * \returns The pointer past the last copied character.
+     * \sa max_length()
+     */
+    C* append(E e, C* out) const noexcept
+    {
+      const auto& entry = _entries[e];
+      std::char_traits<C>::copy(out, _buffer.data() + entry.offset, entry.length);
+      return out + entry.length;
+    }
+
+    /**
+     * \brief Copies the value of \c e to \c out, just like \c std::copy does.
+     *
+     * \returns The output iterator past the last copied character.
+     */
+    template <typename OutputIt>
+    OutputIt append(E e, OutputIt out) const
+    {
+      const auto value = view(e);
+      return std::copy(value.begin(), value.end(), out);
+    }
+
+    /**
+     * \brief Returns the length of the longest value. Handy to size a buffer for \ref append().
+     */
+    std::size_t max_length() const noexcept { return _max_length; }
+
+  private:
+    struct entry
+    {
+      std::uint32_t offset;
+      std::uint32_t length;
+    };
+
+    template <E... es>
+    void add_all(sequence<E, es...>)
+    {
+      // A braced initializer rather than a fold expression, which would nest as deep as the enumeration is large.
+      using expander  = int[];
+      using generator = conversion_generator<E, string_type>;
+
+      static_cast<void>(expander{0, (add(es, typename generator::template impl<es>{}()), 0)...});
+      _buffer.shrink_to_fit();
+    }
+
+    void add(E e, view_type value)
+    {
+      if (_buffer.size() + value.size() > std::numeric_limits<std::uint32_t>::max())
+        throw std::length_error{"The string values don't fit into a pool"};
+
+      _entries[e] = entry{static_cast<std::uint32_t>(_buffer.size()), static_cast<std::uint32_t>(value.size())};
+      _buffer.append(value);
+      _max_length = std::max(_max_length, value.size());
+    }
+
+    string_type     _buffer;
+    array<E, entry> _entries{};
+    std::size_t     _max_length = 0;
+  };
+
+  /** @}*/
+
+  namespace detail
+  {
+    template <typename E, typename C>
+    struct string_pool_storage
+    {
+      static inline std::atomic<const string_pool<E, C>*> pool{nullptr};
+    };
+
+    template <typename E, typename C>
+    const string_pool<E, C>& make_default_string_pool()
+    {
+      static const auto pool = string_pool<E, C>{};
+
+      string_pool_storage<E, C>::pool.store(&pool, std::memory_order_release);
+      return pool;
+    }
+
+    template <typename E, typename C>
+    const string_pool<E, C>& default_string_pool()
+    {
+      const auto pool = string_pool_storage<E, C>::pool.load(std::memory_order_acquire);
+      return pool ? *pool : make_default_string_pool<E, C>();
+    }
+  }
+
+  /** \addtogroup conversionGroup
+   * @{
+   */
+
+  /**
+   * \brief Returns the string value of \c e as a view into the default \ref string_pool for \c E.
+   *
+   * Same value as <tt>convert_to_value<std::basic_string<C>>(e)</tt> returns, but it's stored contiguously with the
+   * rest of the values. The pool is built on first invocation.
+   *
+   * \sa append_name()
+   */
+  template <typename C = char, typename E>
+  std::basic_string_view<C> name_view(E e)
+  {
+    return detail::default_string_pool<E, C>().view(e);
+  }
+
+  /**
+   * \brief Writes the string value of \c e straight into a caller's buffer, which must have room for it.
+   *
+   * Nothing is allocated, and no terminating null is written. Meant for formatters writing enum values at high rates.
+   *
+   * \returns The pointer past the last written character.
+   * \sa name_view()
+   * \sa string_pool
+   */
+  template <typename E, typename C>
+  C* append_name(E e, C* out)
+  {
+    return detail::default_string_pool<E, C>().append(e, out);
+  }
+
+  /**
+   * \brief Writes the string value of \c e to an output iterator of characters of type \c C.
+   *
+   * \returns The output iterator past the last written character.
+   * \sa name_view()
+   * \sa string_pool
+   */
+  template <typename C = char, typename E, typename OutputIt>
+  OutputIt append_name(E e, OutputIt out)
+  {
+    return detail::default_string_pool<E, C>().append(e, out);
+  }
+
+  /** @}*/
+}
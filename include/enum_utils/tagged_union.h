@@ -0,0 +1,344 @@
+#pragma once
+
+/***********************************************************************************************************************
+ * Copyright (c) 2021 Pavel Anikin <codemime@gmail.com>, Renga Software" LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the Software), to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "algorithm.h"
+#include "basic.h"
+#include "dispatch.h"
+#include "exceptions.h"
+#include "sequence.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace enum_utils
+{
+  namespace detail
+  {
+    constexpr bool all_true(std::initializer_list<bool> values) noexcept
+    {
+      for (auto value : values)
+      {
+        if (!value)
+          return false;
+      }
+
+      return true;
+    }
+
+    template <typename E, template <E> typename TItem, typename = sequence_type<E>>
+    struct tagged_union_layout;
+
+    // Braced lists rather than fold expressions, which would nest as deep as the enumeration is large.
+    template <typename E, template <E> typename TItem, E... es>
+    struct tagged_union_layout<E, TItem, sequence<E, es...>>
+    {
+      static constexpr std::size_t size      = std::max({sizeof(TItem<es>)...});
+      static constexpr std::size_t alignment = std::max({alignof(TItem<es>)...});
+
+      static constexpr bool is_trivially_copyable     = all_true({std::is_trivially_copyable<TItem<es>>::value...});
+      static constexpr bool is_trivially_destructible = all_true({std::is_trivially_destructible<TItem<es>>::value...});
+      static constexpr bool is_nothrow_movable = all_true({std::is_nothrow_move_constructible<TItem<es>>::value...});
+    };
+
+    // The storage and the tag. The tag holds the index of the active item rather than the item itself, so it's as
+    // small as the number of the items allows.
+    template <typename E, template <E> typename TItem>
+    class tagged_union_storage
+    {
+    public:
+      E kind() const noexcept { return get<E>(_tag); }
+
+    protected:
+      using layout = tagged_union_layout<E, TItem>;
+
+      tagged_union_storage() = default;
+
+      // The alternative is constructed before any of the classes having a destructor is, so if the construction
+      // throws, nothing is destroyed.
+      template <E e, typename... Args>
+      explicit tagged_union_storage(std::integral_constant<E, e>, Args&&... args)
+      {
+        construct<e>(std::forward<Args>(args)...);
+      }
+
+      template <E e>
+      TItem<e>* pointer() noexcept
+      {
+        return std::launder(reinterpret_cast<TItem<e>*>(_storage));
+      }
+
+      template <E e>
+      const TItem<e>* pointer() const noexcept
+      {
+        return std::launder(reinterpret_cast<const TItem<e>*>(_storage));
+      }
+
+      template <E e, typename... Args>
+      TItem<e>& construct(Args&&... args)
+      {
+        auto result = ::new (static_cast<void*>(_storage)) TItem<e>(std::forward<Args>(args)...);
+        _tag        = static_cast<tag_type>(index(e));
+        return *result;
+      }
+
+      void destroy() noexcept
+      {
+        if constexpr (!layout::is_trivially_destructible)
+        {
+          enum_utils::dispatch(kind(), [this](auto item) {
+            using item_type = TItem<decltype(item)::value>;
+            pointer<decltype(item)::value>()->~item_type();
+          });
+        }
+      }
+
+      void construct_from(const tagged_union_storage& other)
+      {
+        enum_utils::dispatch(other.kind(), [this, &other](auto item) {
+          construct<decltype(item)::value>(*other.template pointer<decltype(item)::value>());
+        });
+      }
+
+      void construct_from(tagged_union_storage&& other) noexcept
+      {
+        enum_utils::dispatch(other.kind(), [this, &other](auto item) {
+          construct<decltype(item)::value>(std::move(*other.template pointer<decltype(item)::value>()));
+        });
+      }
+
+    private:
+      using tag_type = smallest_unsigned_t<size<E>() - 1>;
+
+      alignas(layout::alignment) unsigned char _storage[layout::size];
+      tag_type _tag;
+    };
+
+    // The special members are trivial (and so is the union) when all the items are trivially copyable.
+    template <typename E, template <E> typename TItem, bool = tagged_union_layout<E, TItem>::is_trivially_copyable>
+    class tagged_union_base : public tagged_union_storage<E, TItem>
+    {
+    protected:
+      using tagged_union_storage<E, TItem>::tagged_union_storage;
+    };
+
+    template <typename E, template <E> typename TItem>
+    class tagged_union_base<E, TItem, false> : public tagged_union_storage<E, TItem>
+    {
+    public:
+      tagged_union_base(const tagged_union_base& other) { this->construct_from(other); }
+
+      tagged_union_base(tagged_union_base&& other) noexcept { this->construct_from(std::move(other)); }
+
+      tagged_union_base& operator=(const tagged_union_base& other)
+      {
+        if (this->kind() == other.kind())
+        {
+          enum_utils::dispatch(this->kind(), [this, &other](auto item) {
+            *this->template pointer<decltype(item)::value>() = *other.template pointer<decltype(item)::value>();
+          });
+        }
+        else
+        {
+          // The copy may throw, so it's made before the active item is destroyed.
+          auto copy = other;
+          this->destroy();
+          this->construct_from(std::move(copy));
+        }
+
+        return *this;
+      }
+
+      // Only move construction is required not to throw, so the alternative is reconstructed rather than move assigned,
+      // even if it's of the same item.
+      tagged_union_base& operator=(tagged_union_base&& other) noexcept
+      {
+        if (this != &other)
+        {
+          this->destroy();
+          this->construct_from(std::move(other));
+        }
+
+        return *this;
+      }
+
+      ~tagged_union_base() { this->destroy(); }
+
+    protected:
+      using tagged_union_storage<E, TItem>::tagged_union_storage;
+    };
+  }
+
+  /** \addtogroup containersGroup
+   * @{
+   */
+
+  /**
+   * \brief A discriminated union of the types mapped to each item of \c E, with \c E itself as the discriminant.
+   *
+   * It's what <tt>\ref variadic_type<std::variant, E, TItem></tt> is, except that the active alternative is told by an
+   * item of \c E rather than by an index of its own, so there's nothing to convert between the two. The tag is stored
+   * in the smallest unsigned integer that fits all the items, and the storage is sized and aligned for the largest
+   * alternative. Visitation is a single indirect call through a table generated by \ref dispatch().
+   *
+   * The union is trivially copyable when all the alternatives are, so it can be copied with \c std::memcpy and kept in
+   * bulk without any overhead of its own besides the tag. The alternatives must be nothrow move constructible: the
+   * union always holds a value, even if a copy or a construction throws.
+   *
+   * A default constructed union holds a value initialized alternative of the first item.
+   *
+   * \include tagged_union.cpp
+   */
+  template <typename E, template <E> typename TItem>
+  class tagged_union : public detail::tagged_union_base<E, TItem>, validator<E>
+  {
+    using base_type = detail::tagged_union_base<E, TItem>;
+
+    static_assert(
+        base_type::layout::is_nothrow_movable, "The alternatives of a tagged union must be nothrow move constructible.");
+
+  public:
+    /**
+     * \brief Holds the type mapped to \c e.
+     */
+    template <E e>
+    using item_type = TItem<e>;
+
+    /**
+     * \brief Constructs a value initialized alternative of the first item.
+     */
+    tagged_union() : base_type(std::integral_constant<E, traits<E>::first>{}) {}
+
+    /**
+     * \brief Constructs the alternative of \c e in place, passing \c args to its constructor.
+     */
+    template <E e, typename... Args>
+    explicit tagged_union(std::integral_constant<E, e> item, Args&&... args) :
+      base_type(item, std::forward<Args>(args)...)
+    {
+    }
+
+    /**
+     * \brief Returns the item whose alternative is active.
+     */
+    using base_type::kind;
+
+    /**
+     * \brief Destroys the active alternative and constructs the alternative of \c e in its place.
+     *
+     * If the construction may throw, the new alternative is constructed aside first and moved in afterwards, so the
+     * union keeps its old value on exception.
+     */
+    template <E e, typename... Args>
+    TItem<e>& emplace(Args&&... args)
+    {
+      if constexpr (std::is_nothrow_constructible<TItem<e>, Args...>::value)
+      {
+        this->destroy();
+        return this->template construct<e>(std::forward<Args>(args)...);
+      }
+      else
+      {
+        auto value = TItem<e>(std::forward<Args>(args)...);
+        this->destroy();
+        return this->template construct<e>(std::move(value));
+      }
+    }
+
+    /**
+     * \brief Returns the alternative of \c e.
+     *
+     * \throws bad_access The alternative of \c e isn't active.
+     */
+    template <E e>
+    TItem<e>& get()
+    {
+      check<e>();
+      return *this->template pointer<e>();
+    }
+
+    /**
+     * \copydoc get()
+     */
+    template <E e>
+    const TItem<e>& get() const
+    {
+      check<e>();
+      return *this->template pointer<e>();
+    }
+
+    /**
+     * \brief Returns a pointer to the alternative of \c e, or \c nullptr if it isn't active.
+     */
+    template <E e>
+    TItem<e>* get_if() noexcept
+    {
+      return kind() == e ? this->template pointer<e>() : nullptr;
+    }
+
+    /**
+     * \copydoc get_if()
+     */
+    template <E e>
+    const TItem<e>* get_if() const noexcept
+    {
+      return kind() == e ? this->template pointer<e>() : nullptr;
+    }
+
+    /**
+     * \brief Invokes \c f with the active alternative and its item.
+     *
+     * The item is passed as the last argument, as a \c std::integral_constant, or as a template parameter of the call
+     * operator, just like \ref for_each() does. All the invocations must return the same type.
+     */
+    template <typename F>
+    decltype(auto) visit(F&& f)
+    {
+      return dispatch(kind(), [this, &f](auto item) -> decltype(auto) {
+        return detail::invoke_with_item<E, decltype(item)::value>(f, *this->template pointer<decltype(item)::value>());
+      });
+    }
+
+    /**
+     * \copydoc visit()
+     */
+    template <typename F>
+    decltype(auto) visit(F&& f) const
+    {
+      return dispatch(kind(), [this, &f](auto item) -> decltype(auto) {
+        return detail::invoke_with_item<E, decltype(item)::value>(f, *this->template pointer<decltype(item)::value>());
+      });
+    }
+
+  private:
+    template <E e>
+    void check() const
+    {
+      if (kind() != e)
+        throw bad_access{"The requested alternative of the tagged union isn't active"};
+    }
+  };
+
+  /** @}*/
+}
@@ -30,7 +30,8 @@ namespace enum_utils
   /**
    * \brief The structure containing traits for \c E.
    *
-   * Can be defined using \ref ENUM_UTILS_DEFINE_TRAITS() or \ref ENUM_UTILS_DEFINE_TRAITS_FL().
+   * Can be defined using \ref ENUM_UTILS_DEFINE_TRAITS() or \ref ENUM_UTILS_DEFINE_TRAITS_FL(), or using
+   * \ref ENUM_UTILS_DEFINE_TRAITS_ITEMS() for enumerations with gaps.
    */
   template <typename E>
   struct traits;
@@ -64,6 +65,18 @@ namespace enum_utils
           "Traits for the enum are not defined (use `ENUM_UTILS_DEFINE_TRAITS()` macro).");
     };
 
+    // Enumerations with gaps list their items (see `ENUM_UTILS_DEFINE_TRAITS_ITEMS()`), and their traits provide
+    // the items along with the way to find the index of an item.
+    template <typename E, typename = void>
+    struct is_sparse : std::false_type
+    {
+    };
+
+    template <typename E>
+    struct is_sparse<E, std::void_t<decltype(traits<E>::items)>> : std::true_type
+    {
+    };
+
     template <typename E, E _first, E _last, typename = type_validator<E>>
     struct traits_helper
     {